@@ -0,0 +1,188 @@
+/**
+ * @file      cpu.BitBand.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_BITBAND_HPP_
+#define CPU_BITBAND_HPP_
+
+#include "cpu.Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class BitBand
+ * @brief Cortex-M3 bit-band alias access.
+ *
+ * A word write to a bit-band alias changes the only bit in the bit-band region
+ * in one bus transaction, thus the change is atomic without interrupts masking.
+ *
+ * SRAM      : 0x20000000 - 0x200FFFFF is aliased to 0x22000000 - 0x23FFFFFF;
+ * Peripheral: 0x40000000 - 0x400FFFFF is aliased to 0x42000000 - 0x43FFFFFF.
+ *
+ * @note The System Control Space (SysTick, NVIC, SCB and MPU) is not in a bit-band region.
+ *       A register out of the regions is changed by a read-modify-write sequence, which is
+ *       not atomic.
+ */
+class BitBand
+{
+
+public:
+
+    /**
+     * @brief Tests if an address is in a bit-band region.
+     *
+     * @param address An address.
+     * @return True if the address has bit-band alias.
+     */
+    static bool_t isBitBand(const volatile void* address);
+
+    /**
+     * @brief Returns an alias word of a bit.
+     *
+     * @param address An address in a bit-band region.
+     * @param bit     A bit number of a word starting from the address.
+     * @return The alias word address, or a null pointer if the address is not in a bit-band region.
+     */
+    static volatile uint32_t* getAlias(const volatile void* address, uint32_t bit);
+
+    /**
+     * @brief Sets a bit of a register to 1.
+     *
+     * @param reg A register of a reg:: register model.
+     * @param bit A bit number of the register.
+     */
+    template <typename R>
+    static void set(R& reg, typename R::Value bit);
+
+    /**
+     * @brief Clears a bit of a register to 0.
+     *
+     * @param reg A register of a reg:: register model.
+     * @param bit A bit number of the register.
+     */
+    template <typename R>
+    static void clear(R& reg, typename R::Value bit);
+
+    /**
+     * @brief Writes a bit of a register.
+     *
+     * @param reg   A register of a reg:: register model.
+     * @param bit   A bit number of the register.
+     * @param value A bit value.
+     */
+    template <typename R>
+    static void write(R& reg, typename R::Value bit, bool_t value);
+
+    /**
+     * @brief Reads a bit of a register.
+     *
+     * @param reg A register of a reg:: register model.
+     * @param bit A bit number of the register.
+     * @return The bit value.
+     */
+    template <typename R>
+    static bool_t read(const R& reg, typename R::Value bit);
+
+private:
+
+    /**
+     * @brief SRAM bit-band region and alias.
+     */
+    static const uint32_t SRAM_REGION = 0x20000000;
+    static const uint32_t SRAM_ALIAS  = 0x22000000;
+
+    /**
+     * @brief Peripheral bit-band region and alias.
+     */
+    static const uint32_t PERIPHERAL_REGION = 0x40000000;
+    static const uint32_t PERIPHERAL_ALIAS  = 0x42000000;
+
+    /**
+     * @brief Size of a bit-band region.
+     */
+    static const uint32_t REGION_SIZE = 0x00100000;
+
+};
+
+inline bool_t BitBand::isBitBand(const volatile void* address)
+{
+    uint32_t const addr( reinterpret_cast<uint32_t>(address) );
+    if( SRAM_REGION <= addr && addr < SRAM_REGION + REGION_SIZE )
+    {
+        return true;
+    }
+    if( PERIPHERAL_REGION <= addr && addr < PERIPHERAL_REGION + REGION_SIZE )
+    {
+        return true;
+    }
+    return false;
+}
+
+inline volatile uint32_t* BitBand::getAlias(const volatile void* address, uint32_t bit)
+{
+    uint32_t const addr( reinterpret_cast<uint32_t>(address) + (bit >> 3) );
+    uint32_t alias( 0 );
+    if( SRAM_REGION <= addr && addr < SRAM_REGION + REGION_SIZE )
+    {
+        alias = SRAM_ALIAS + ( (addr - SRAM_REGION) << 5 );
+    }
+    else if( PERIPHERAL_REGION <= addr && addr < PERIPHERAL_REGION + REGION_SIZE )
+    {
+        alias = PERIPHERAL_ALIAS + ( (addr - PERIPHERAL_REGION) << 5 );
+    }
+    else
+    {
+        return NULLPTR;
+    }
+    alias += (bit & 0x7U) << 2;
+    return reinterpret_cast<volatile uint32_t*>(alias);
+}
+
+template <typename R>
+inline void BitBand::set(R& reg, typename R::Value bit)
+{
+    write(reg, bit, true);
+}
+
+template <typename R>
+inline void BitBand::clear(R& reg, typename R::Value bit)
+{
+    write(reg, bit, false);
+}
+
+template <typename R>
+inline void BitBand::write(R& reg, typename R::Value bit, bool_t value)
+{
+    volatile uint32_t* const alias( getAlias(&reg, bit) );
+    if( alias != NULLPTR )
+    {
+        *alias = value ? 1U : 0U;
+    }
+    else if( value )
+    {
+        reg.value = reg.value | static_cast<typename R::Value>(1U << bit);
+    }
+    else
+    {
+        reg.value = reg.value & static_cast<typename R::Value>(~(1U << bit));
+    }
+}
+
+template <typename R>
+inline bool_t BitBand::read(const R& reg, typename R::Value bit)
+{
+    volatile uint32_t* const alias( getAlias(&reg, bit) );
+    if( alias != NULLPTR )
+    {
+        return *alias != 0U;
+    }
+    return ( (reg.value >> bit) & 1U ) != 0U;
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_BITBAND_HPP_
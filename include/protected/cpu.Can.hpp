@@ -0,0 +1,2177 @@
+/**
+ * @file      cpu.Can.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CAN_HPP_
+#define CPU_CAN_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "api.Runnable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+#include "cpu.Interrupt.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.CanFrame.hpp"
+#include "cpu.CanFilter.hpp"
+#include "cpu.CanBitTiming.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Can
+ * @brief CPU HW bxCAN resource.
+ *
+ * Frames to transmit are put to a software priority queue, which is a binary heap ordered by
+ * the arbitration field of frames and then by their queueing order. The three TX mailboxes are
+ * kept loaded with the highest priority frames of the queue, and the mailboxes are transmitted
+ * by identifier priority as MCR TXFP is cleared. If all mailboxes are loaded and a frame of a
+ * higher priority than a loaded one is queued, the lowest priority mailbox is aborted and its
+ * frame is put back to the queue. The mailboxes are refilled on RQCP in the TX interrupt handler.
+ * Frames of one arbitration field are never loaded to two mailboxes at once, thus they are
+ * transmitted in their queueing order.
+ *
+ * Received frames are moved from both RX FIFOs to a ring of fixed slots, and they are read in
+ * place. If the ring is full, frames are left in the FIFOs and the FIFO interrupts are disabled
+ * until a slot is released. A listener may consume frames in the RX interrupt handler before they
+ * are put to the ring, thus a protocol layer is not woken up per frame. With the time triggered
+ * communication mode, the 16 bits time stamp of SOF in CAN bit times is extended to 64 bits by
+ * the CPU clock cycles elapsed between frames, which are an exact number of bit times as the CAN
+ * clock is derived from the CPU clock.
+ *
+ * The error state is tracked by the error status register on the SCE interrupt, which is raised
+ * when the error warning, error passive or bus-off flag is set, and on the TX and RX interrupts,
+ * which see the state going back as frames are transmitted and received. A handler is called
+ * when a state is entered. The SCE interrupt is also raised on each error detected on the bus
+ * to count it, while arbitration losses and transmission errors of frames are counted by their
+ * last attempts. The bus-off state is left by the hardware automatically, or after
+ * a back-off timeout of a basic timer, which doubles on each bus-off until a frame is transmitted.
+ *
+ * In the sleep mode the controller is woken up by software, by a frame queued to transmit, or
+ * by the hardware on SOF of the bus if the automatic wake-up is enabled. The configuration, the
+ * filters and the frames of the RX FIFOs are kept in the sleep mode. The frame which wakes the
+ * controller up is not received, as the controller synchronizes to the bus by 11 recessive bits.
+ *
+ * @note The resource uses two Interrupt resources of InterruptController, two more if frames are
+ *       received, and one more for the managed bus-off recovery.
+ * @note updateTime() is called at least once a period of the CPU clock cycle counter, like from
+ *       a system tick, for the extended time stamp to be right if no frame is received that long.
+ *
+ * @tparam A Heap memory allocator class.
+ */
+template <class A>
+class Can : public NonCopyable<A>
+{
+    typedef NonCopyable<A> Parent;
+
+public:
+
+    /**
+     * @enum State
+     * @brief Error states.
+     */
+    enum State
+    {
+        STATE_ERROR_ACTIVE = 0, ///< Both error counters are below 96
+        STATE_ERROR_WARNING,    ///< An error counter is 96 or more
+        STATE_ERROR_PASSIVE,    ///< An error counter is above 127
+        STATE_BUS_OFF,          ///< The transmit error counter is above 255
+        NUMBER_OF_STATES
+    };
+
+    /**
+     * @enum Mode
+     * @brief Test modes.
+     */
+    enum Mode
+    {
+        MODE_NORMAL = 0,      ///< Frames are transmitted to and received from the bus
+        MODE_LOOPBACK,        ///< Frames are transmitted to the bus and received back only, which is self-test
+        MODE_SILENT,          ///< Frames are received from the bus, and only recessive bits are sent to it
+        MODE_SILENT_LOOPBACK  ///< Frames are received back only and nothing is sent to the bus, which is hot self-test
+    };
+
+    /**
+     * @enum Recovery
+     * @brief Bus-off recovery methods.
+     */
+    enum Recovery
+    {
+        RECOVERY_AUTOMATIC = 0, ///< The hardware leaves bus-off after 128 occurrences of 11 recessive bits
+        RECOVERY_MANAGED,       ///< The resource requests leaving bus-off after a back-off timeout
+        RECOVERY_MANUAL         ///< The application requests leaving bus-off by recover()
+    };
+
+    /**
+     * @struct Statistics
+     * @brief Statistics counters, which wrap at 2^32.
+     */
+    struct Statistics
+    {
+        /**
+         * @brief Constructor of zero counters.
+         */
+        Statistics();
+
+        /**
+         * @brief Number of transmitted frames.
+         */
+        uint32_t txFrames;
+
+        /**
+         * @brief Number of frames put to the RX ring.
+         */
+        uint32_t rxFrames;
+
+        /**
+         * @brief Number of RX FIFO 0 overruns, each of which has lost one frame at least.
+         */
+        uint32_t rxOverrun0;
+
+        /**
+         * @brief Number of RX FIFO 1 overruns, each of which has lost one frame at least.
+         */
+        uint32_t rxOverrun1;
+
+        /**
+         * @brief Number of transmitted or aborted frames which lost arbitration in their last attempt.
+         */
+        uint32_t arbitrationLost;
+
+        /**
+         * @brief Number of transmitted or aborted frames which had a transmission error in their last attempt.
+         */
+        uint32_t txErrors;
+
+        /**
+         * @brief Number of errors detected on the bus, each of which is counted by its last error code.
+         */
+        uint32_t busErrors;
+
+        /**
+         * @brief Number of entries to the error warning state.
+         */
+        uint32_t errorWarning;
+
+        /**
+         * @brief Number of entries to the error passive state.
+         */
+        uint32_t errorPassive;
+
+        /**
+         * @brief Number of entries to the bus-off state.
+         */
+        uint32_t busOff;
+
+        /**
+         * @brief Transmit error counter at the time of reading.
+         */
+        uint32_t tec;
+
+        /**
+         * @brief Receive error counter at the time of reading.
+         */
+        uint32_t rec;
+
+        /**
+         * @brief Last error code at the time of reading.
+         */
+        uint32_t lec;
+
+        /**
+         * @brief Total CPU clock cycles of the CAN interrupt handlers.
+         */
+        uint32_t isrCycles;
+    };
+
+    /**
+     * @struct TxEntry
+     * @brief Entry of the TX priority queue.
+     */
+    struct TxEntry
+    {
+        /**
+         * @brief Constructor of an empty entry.
+         */
+        TxEntry();
+
+        /**
+         * @brief A frame to transmit.
+         */
+        CanFrame frame;
+
+        /**
+         * @brief The arbitration field of the frame.
+         */
+        uint32_t arbitration;
+
+        /**
+         * @brief Queueing order of the frame.
+         */
+        uint32_t sequence;
+
+        /**
+         * @brief CPU clock cycles when the frame is queued.
+         */
+        uint32_t cycles;
+    };
+
+    /**
+     * @struct RxFrame
+     * @brief Slot of the RX ring.
+     */
+    struct RxFrame
+    {
+        /**
+         * @brief Constructor of an empty slot.
+         */
+        RxFrame();
+
+        /**
+         * @brief A received frame.
+         */
+        CanFrame frame;
+
+        /**
+         * @brief Time of SOF of the frame in CAN bit times since initialization, or zero.
+         */
+        uint64_t time;
+
+        /**
+         * @brief FIFO index.
+         */
+        int32_t fifo;
+
+        /**
+         * @brief Filter match index.
+         */
+        uint32_t fmi;
+    };
+
+    /**
+     * @class Listener
+     * @brief Receiver of frames in the RX interrupt handler.
+     */
+    class Listener
+    {
+
+    public:
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Listener() {}
+
+        /**
+         * @brief Takes a received frame before it is put to the RX ring.
+         *
+         * @param frame A frame, which is valid only until the function returns.
+         * @return True if the frame is consumed, and it is not put to the RX ring.
+         */
+        virtual bool_t accept(const RxFrame& frame) = 0;
+    };
+
+    /**
+     * @class Monitor
+     * @brief Observer of frames on the bus in the TX and RX interrupt handlers.
+     */
+    class Monitor
+    {
+
+    public:
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Monitor() {}
+
+        /**
+         * @brief Observes a received frame when it is taken from an RX FIFO.
+         *
+         * @param frame A frame.
+         */
+        virtual void received(const RxFrame& frame) = 0;
+
+        /**
+         * @brief Observes a transmitted frame.
+         *
+         * @param frame  A frame.
+         * @param cycles CPU clock cycles from transmit() of the frame to the TX interrupt of its transmission.
+         */
+        virtual void transmitted(const CanFrame& frame, uint32_t cycles) = 0;
+    };
+
+    /**
+     * @struct Config
+     * @brief CAN configuration.
+     */
+    struct Config
+    {
+        /**
+         * @brief Constructor of default configuration.
+         */
+        Config();
+
+        /**
+         * @brief Bit rate.
+         */
+        int32_t bitRate;
+
+        /**
+         * @brief Sample point in per mille of a bit.
+         */
+        int32_t samplePoint;
+
+        /**
+         * @brief Bit timing register value, or zero to calculate it for the bit rate and the sample point from PCLK1.
+         */
+        uint32_t btr;
+
+        /**
+         * @brief TX priority queue memory.
+         */
+        TxEntry* txBuffer;
+
+        /**
+         * @brief Number of TX priority queue entries, which includes frames loaded to the mailboxes.
+         */
+        size_t txSize;
+
+        /**
+         * @brief RX ring memory, or a null pointer not to receive frames.
+         */
+        RxFrame* rxBuffer;
+
+        /**
+         * @brief Number of RX ring slots, which is a power of two.
+         */
+        size_t rxSize;
+
+        /**
+         * @brief Enable time triggered communication mode to time stamp received frames.
+         *
+         * @note updateTime() is called at least every 2^32 CPU clock cycles to keep the time.
+         */
+        bool_t isTimestamp;
+
+        /**
+         * @brief Test mode.
+         */
+        Mode mode;
+
+        /**
+         * @brief Bus-off recovery method.
+         */
+        Recovery recovery;
+
+        /**
+         * @brief Basic timer index as Registers::INDEX_TIMx is for the managed bus-off recovery, which is not used by LIN.
+         */
+        int32_t timer;
+
+        /**
+         * @brief First back-off timeout of the managed bus-off recovery in microseconds.
+         */
+        uint32_t backOff;
+
+        /**
+         * @brief Maximal back-off timeout of the managed bus-off recovery in microseconds.
+         */
+        uint32_t backOffMax;
+
+        /**
+         * @brief Handlers called in an interrupt handler when the states are entered, or null pointers.
+         */
+        api::Runnable* stateHandler[NUMBER_OF_STATES];
+
+        /**
+         * @brief Leave the sleep mode on SOF of the bus.
+         */
+        bool_t isAutoWakeUp;
+
+        /**
+         * @brief Handler called in an interrupt handler when the sleep mode is left on SOF, or a null pointer.
+         */
+        api::Runnable* wakeUpHandler;
+    };
+
+    /**
+     * @struct Data
+     * @brief Global data for all these objects;
+     */
+    struct Data
+    {
+        /**
+         * @brief Constructor.
+         *
+         * @param reg  Target CPU register model.
+         * @param gie  Global interrupt enable controller.
+         * @param ic   Interrupt controller.
+         * @param gpio General-purpose input output pins.
+         * @param pll  PLL controller.
+         */
+        Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, PllController& apll);
+
+        /**
+         * @brief Target CPU register model.
+         */
+        Registers& reg;
+
+        /**
+         * @brief Global interrupt enable controller.
+         */
+        api::Guard& gie;
+
+        /**
+         * @brief Interrupt controller.
+         */
+        api::CpuInterruptController& ic;
+
+        /**
+         * @brief General-purpose input output pins.
+         */
+        Gpio& gpio;
+
+        /**
+         * @brief PLL controller.
+         */
+        PllController& pll;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param data   Global data for all theses objects.
+     * @param index  CAN index as Registers::INDEX_CANx is.
+     * @param config Configuration.
+     */
+    Can(Data& data, int32_t index, const Config& config);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Can();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Queues a frame to transmit.
+     *
+     * @param frame A frame.
+     * @return True if the frame is queued.
+     */
+    bool_t transmit(const CanFrame& frame);
+
+    /**
+     * @brief Sets the acceptance filter banks.
+     *
+     * Reception of frames is stopped while the banks are set, and banks not compiled are deactivated.
+     *
+     * @param filter Compiled filter.
+     * @return True if the banks are set.
+     */
+    bool_t setFilter(const CanFilter& filter);
+
+    /**
+     * @brief Returns the oldest received frame in place.
+     *
+     * @return The frame, or a null pointer if no frame is received.
+     */
+    const RxFrame* receive();
+
+    /**
+     * @brief Releases the oldest received frame slot.
+     */
+    void release();
+
+    /**
+     * @brief Sets a receiver of frames in the RX interrupt handler.
+     *
+     * @param listener A listener, or a null pointer to put all frames to the RX ring.
+     * @return True if the listener is set.
+     */
+    bool_t setListener(Listener* listener);
+
+    /**
+     * @brief Sets an observer of frames on the bus.
+     *
+     * @param monitor A monitor, or a null pointer.
+     * @return True if the monitor is set.
+     */
+    bool_t setMonitor(Monitor* monitor);
+
+    /**
+     * @brief Returns the error state.
+     *
+     * @return The state.
+     */
+    State getState() const;
+
+    /**
+     * @brief Requests leaving the bus-off state.
+     *
+     * @return True if the request is made.
+     */
+    bool_t recover();
+
+    /**
+     * @brief Returns statistics counters.
+     *
+     * @param statistics Statistics counters.
+     */
+    void getStatistics(Statistics& statistics) const;
+
+    /**
+     * @brief Returns the achieved bit timing.
+     *
+     * @return The bit timing, which error is zero if a raw BTR value is configured.
+     */
+    const CanBitTiming::Result& getBitTiming() const;
+
+    /**
+     * @brief Returns number of frames which are queued or loaded to the mailboxes.
+     *
+     * @return Number of frames.
+     */
+    size_t getPending() const;
+
+    /**
+     * @brief Enters the sleep mode.
+     *
+     * The mode is entered when the bus is idle.
+     *
+     * @return True if the mode is acknowledged, or false if frames are pending or the mode is not
+     *         acknowledged in time, in which case the request is cancelled.
+     */
+    bool_t sleep();
+
+    /**
+     * @brief Leaves the sleep mode.
+     *
+     * @return True if the controller is synchronized to the bus.
+     */
+    bool_t wakeUp();
+
+    /**
+     * @brief Tests if the controller is in the sleep mode.
+     *
+     * @return True if it sleeps.
+     */
+    bool_t isSleeping() const;
+
+    /**
+     * @brief Moves the time of the last received frame to the current CPU clock cycles.
+     *
+     * Received frames are time stamped by the CPU clock cycles since the last frame, which are
+     * counted by a 32 bits counter, thus the function is called at least every 2^32 CPU clock
+     * cycles, which is about 59 seconds at 72 MHz, like from a system tick, if frames may be not
+     * received for that long.
+     */
+    void updateTime();
+
+    /**
+     * @brief Returns the CAN index.
+     *
+     * @return The index.
+     */
+    int32_t getIndex() const;
+
+    /**
+     * @brief Tests if a CAN index is valid.
+     *
+     * @param index A CAN index.
+     * @return True if it is valid.
+     */
+    static bool_t isIndex(int32_t index);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @class Handler
+     * @brief Interrupt handler which calls a function of the resource.
+     */
+    class Handler : public api::Runnable
+    {
+
+    public:
+
+        /**
+         * @brief A function of the resource.
+         */
+        typedef void (Can::*Function)();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param can      The resource.
+         * @param function A function to call.
+         */
+        Handler(Can& can, Function function);
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Handler();
+
+        /**
+         * @copydoc eoos::api::Object::isConstructed()
+         */
+        virtual bool_t isConstructed() const;
+
+        /**
+         * @copydoc eoos::api::Runnable::start()
+         */
+        virtual void start();
+
+    private:
+
+        /**
+         * @brief The resource.
+         */
+        Can& can_;
+
+        /**
+         * @brief A function to call.
+         */
+        Function function_;
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the hardware.
+     *
+     * @return True if initialized.
+     */
+    bool_t initialize();
+
+    /**
+     * @brief Deinitializes the hardware.
+     */
+    void deinitialize();
+
+    /**
+     * @brief Calculates the bit timing.
+     *
+     * @return True if the bit rate is achievable.
+     */
+    bool_t initializeBitTiming();
+
+    /**
+     * @brief Initializes the basic timer of the managed bus-off recovery.
+     *
+     * @return True if initialized.
+     */
+    bool_t initializeTimer();
+
+    /**
+     * @brief Requests or leaves the initialization mode.
+     *
+     * @param enter True to request the mode.
+     * @return True if the mode is acknowledged.
+     */
+    bool_t setInitialization(bool_t enter);
+
+    /**
+     * @brief Creates an interrupt resource.
+     *
+     * @param handler   An interrupt handler.
+     * @param exception An exception number.
+     * @return The interrupt resource, or a null pointer if an error has been occurred.
+     */
+    api::CpuInterrupt* createInterrupt(api::Runnable& handler, int32_t exception);
+
+    /**
+     * @brief Handles the TX interrupt.
+     */
+    void handleTx();
+
+    /**
+     * @brief Handles the status change and error interrupt.
+     */
+    void handleSce();
+
+    /**
+     * @brief Handles the back-off timer interrupt.
+     */
+    void handleTimer();
+
+    /**
+     * @brief Updates the error state by the error status register.
+     */
+    void updateState();
+
+    /**
+     * @brief Requests the initialization mode and leaves it without waiting, which starts bus-off recovery.
+     *
+     * @return True if the request is made.
+     */
+    bool_t restart();
+
+    /**
+     * @brief Handles the RX FIFO 0 interrupt.
+     */
+    void handleRx0();
+
+    /**
+     * @brief Handles the RX FIFO 1 interrupt.
+     */
+    void handleRx1();
+
+    /**
+     * @brief Moves frames of an RX FIFO to the RX ring.
+     *
+     * @param fifo A FIFO index.
+     */
+    void handleRx(int32_t fifo);
+
+    /**
+     * @brief Extends a time stamp.
+     *
+     * @param stamp  A 16 bits time stamp in bit times.
+     * @param cycles CPU clock cycles of the stamp reading.
+     * @return The extended time stamp.
+     */
+    uint64_t extendTime(uint32_t stamp, uint32_t cycles);
+
+    /**
+     * @brief Enables or disables an RX FIFO message pending interrupt.
+     *
+     * @param fifo   A FIFO index.
+     * @param enable True to enable.
+     */
+    void enableRx(int32_t fifo, bool_t enable);
+
+    /**
+     * @brief Loads free mailboxes, and aborts a mailbox preempted by a queued frame.
+     */
+    void schedule();
+
+    /**
+     * @brief Loads a mailbox with a frame.
+     *
+     * @param mailbox A mailbox index.
+     * @param entry   An entry of the frame.
+     */
+    void load(int32_t mailbox, const TxEntry& entry);
+
+    /**
+     * @brief Tests if a mailbox is loaded with a frame of an arbitration field.
+     *
+     * @param arbitration An arbitration field.
+     * @return True if the mailbox is loaded.
+     */
+    bool_t isLoaded(uint32_t arbitration) const;
+
+    /**
+     * @brief Puts an entry to the TX priority queue.
+     *
+     * @param entry An entry.
+     */
+    void push(const TxEntry& entry);
+
+    /**
+     * @brief Removes the highest priority entry from the TX priority queue.
+     *
+     * @param entry The removed entry.
+     */
+    void pop(TxEntry& entry);
+
+    /**
+     * @brief Tests if an entry is transmitted before another.
+     *
+     * @param entry1 An entry.
+     * @param entry2 Another entry.
+     * @return True if the first entry has higher priority.
+     */
+    static bool_t isHigher(const TxEntry& entry1, const TxEntry& entry2);
+
+    /**
+     * @brief Enables or disables the CAN clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableClock(bool_t enable);
+
+    /**
+     * @brief Enables or disables the back-off timer clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableTimerClock(bool_t enable);
+
+    /**
+     * @brief Sets the CAN pins to their alternate functions.
+     *
+     * @return True if the pins are set.
+     */
+    bool_t initializePins();
+
+    /**
+     * @brief Number of TX mailboxes.
+     */
+    static const int32_t NUMBER_OF_MAILBOXES = 3;
+
+    /**
+     * @brief Timeout of waiting for INAK.
+     */
+    static const int32_t REG_CAN_INAK_TIMEOUT = 0xFFFF;
+
+    /**
+     * @brief Back-off timer tick in microseconds.
+     */
+    static const uint32_t TIMER_TICK = 100;
+
+    /**
+     * @brief Maximal number of back-off timer ticks.
+     */
+    static const uint32_t TIMER_TICKS_MAX = 0x00010000;
+
+    /**
+     * @brief Last error code of no error.
+     */
+    static const uint32_t LEC_NO_ERROR = 0;
+
+    /**
+     * @brief Last error code set by software.
+     */
+    static const uint32_t LEC_SOFTWARE = 7;
+
+    /**
+     * @brief Global data for all these objects;
+     */
+    Data& data_;
+
+    /**
+     * @brief CAN index.
+     */
+    int32_t index_;
+
+    /**
+     * @brief Configuration.
+     */
+    Config config_;
+
+    /**
+     * @brief CAN registers.
+     */
+    reg::Can* can_;
+
+    /**
+     * @brief Achieved bit timing.
+     */
+    CanBitTiming::Result timing_;
+
+    /**
+     * @brief TX interrupt handler.
+     */
+    Handler txHandler_;
+
+    /**
+     * @brief TX interrupt resource.
+     */
+    api::CpuInterrupt* txInt_;
+
+    /**
+     * @brief Status change and error interrupt handler.
+     */
+    Handler sceHandler_;
+
+    /**
+     * @brief Status change and error interrupt resource.
+     */
+    api::CpuInterrupt* sceInt_;
+
+    /**
+     * @brief Back-off timer interrupt handler.
+     */
+    Handler timHandler_;
+
+    /**
+     * @brief Back-off timer interrupt resource.
+     */
+    api::CpuInterrupt* timInt_;
+
+    /**
+     * @brief Back-off timer registers.
+     */
+    reg::Tim* tim_;
+
+    /**
+     * @brief Error state.
+     */
+    State volatile state_;
+
+    /**
+     * @brief Next back-off timeout in microseconds.
+     */
+    uint32_t backOff_;
+
+    /**
+     * @brief Statistics counters, which are updated only in interrupt handlers of one priority.
+     */
+    Statistics volatile statistics_;
+
+    /**
+     * @brief RX FIFO 0 interrupt handler.
+     */
+    Handler rx0Handler_;
+
+    /**
+     * @brief RX FIFO 1 interrupt handler.
+     */
+    Handler rx1Handler_;
+
+    /**
+     * @brief RX FIFO interrupt resources.
+     */
+    api::CpuInterrupt* rxInt_[2];
+
+    /**
+     * @brief Number of frames put to the RX ring.
+     */
+    uint32_t volatile rxHead_;
+
+    /**
+     * @brief Number of frames released from the RX ring.
+     */
+    uint32_t volatile rxTail_;
+
+    /**
+     * @brief Receiver of frames in the RX interrupt handler.
+     */
+    Listener* volatile listener_;
+
+    /**
+     * @brief Observer of frames on the bus.
+     */
+    Monitor* volatile monitor_;
+
+    /**
+     * @brief Slot to read a frame to a listener if the RX ring is full.
+     */
+    RxFrame rxSpare_;
+
+    /**
+     * @brief Time stamp of the last received frame.
+     */
+    uint64_t rxTime_;
+
+    /**
+     * @brief CPU clock cycles of the last received frame.
+     */
+    uint32_t rxCycles_;
+
+    /**
+     * @brief CPU clock cycles of a CAN bit time.
+     */
+    uint32_t cyclesPerBit_;
+
+    /**
+     * @brief Number of entries in the TX priority queue.
+     */
+    size_t txLength_;
+
+    /**
+     * @brief Queueing order of a next frame.
+     */
+    uint32_t txSequence_;
+
+    /**
+     * @brief Frames loaded to the mailboxes.
+     */
+    TxEntry mailbox_[NUMBER_OF_MAILBOXES];
+
+    /**
+     * @brief The mailboxes are loaded.
+     */
+    bool_t isMailbox_[NUMBER_OF_MAILBOXES];
+
+    /**
+     * @brief Mailbox being aborted, or -1.
+     */
+    int32_t abort_;
+
+};
+
+template <class A>
+Can<A>::Can(Data& data, int32_t index, const Config& config)
+    : NonCopyable<A>()
+    , data_( data )
+    , index_( index )
+    , config_( config )
+    , can_( isIndex(index) ? data.reg.can[index] : NULLPTR )
+    , timing_()
+    , txHandler_( *this, &Can::handleTx )
+    , txInt_( NULLPTR )
+    , sceHandler_( *this, &Can::handleSce )
+    , sceInt_( NULLPTR )
+    , timHandler_( *this, &Can::handleTimer )
+    , timInt_( NULLPTR )
+    , tim_( NULLPTR )
+    , state_( STATE_ERROR_ACTIVE )
+    , backOff_( config.backOff )
+    , statistics_()
+    , rx0Handler_( *this, &Can::handleRx0 )
+    , rx1Handler_( *this, &Can::handleRx1 )
+    , rxInt_()
+    , rxHead_( 0 )
+    , rxTail_( 0 )
+    , listener_( NULLPTR )
+    , monitor_( NULLPTR )
+    , rxSpare_()
+    , rxTime_( 0 )
+    , rxCycles_( 0 )
+    , cyclesPerBit_( 0 )
+    , txLength_( 0 )
+    , txSequence_( 0 )
+    , mailbox_()
+    , isMailbox_()
+    , abort_( -1 ) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+template <class A>
+Can<A>::~Can()
+{
+    deinitialize();
+}
+
+template <class A>
+bool_t Can<A>::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+template <class A>
+bool_t Can<A>::transmit(const CanFrame& frame)
+{
+    if( !isConstructed() || !frame.isFrame() )
+    {
+        return false;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    // The queue keeps room for the frames of the mailboxes to put them back on abort
+    if( getPending() >= config_.txSize )
+    {
+        return false;
+    }
+    TxEntry entry;
+    entry.frame = frame;
+    entry.arbitration = frame.getArbitration();
+    entry.sequence = txSequence_++;
+    entry.cycles = data_.reg.dwt->cyccnt.value;
+    // A frame to transmit wakes the controller up, and it is transmitted when the controller is synchronized
+    if( can_->mcr.bit.sleep != 0U )
+    {
+        can_->mcr.bit.sleep = 0;
+    }
+    push(entry);
+    schedule();
+    return true;
+}
+
+template <class A>
+bool_t Can<A>::setFilter(const CanFilter& filter)
+{
+    if( !isConstructed() || !filter.isConstructed() )
+    {
+        return false;
+    }
+    reg::Can::Fm1r::Value fm1r(0);
+    reg::Can::Fs1r::Value fs1r(0);
+    reg::Can::Ffa1r::Value ffa1r(0);
+    reg::Can::Fa1r::Value fa1r(0);
+    can_->fmr.bit.finit = 1;
+    can_->fa1r.value = 0;
+    for(int32_t i(0); i<filter.getBanks(); i++)
+    {
+        CanFilter::Bank const& bank( filter.getBank(i) );
+        uint32_t const bit( 1U << i );
+        if( bank.isList )
+        {
+            fm1r |= bit;
+        }
+        if( bank.isWide )
+        {
+            fs1r |= bit;
+        }
+        if( bank.fifo != 0 )
+        {
+            ffa1r |= bit;
+        }
+        fa1r |= bit;
+        can_->firx[i][0].value = bank.fr1;
+        can_->firx[i][1].value = bank.fr2;
+    }
+    can_->fm1r.value = fm1r;
+    can_->fs1r.value = fs1r;
+    can_->ffa1r.value = ffa1r;
+    can_->fa1r.value = fa1r;
+    can_->fmr.bit.finit = 0;
+    return true;
+}
+
+template <class A>
+const typename Can<A>::RxFrame* Can<A>::receive()
+{
+    if( !isConstructed() || config_.rxBuffer == NULLPTR )
+    {
+        return NULLPTR;
+    }
+    uint32_t const tail( rxTail_ );
+    if( rxHead_ == tail )
+    {
+        return NULLPTR;
+    }
+    return &config_.rxBuffer[tail & (config_.rxSize - 1U)];
+}
+
+template <class A>
+void Can<A>::release()
+{
+    if( !isConstructed() || config_.rxBuffer == NULLPTR )
+    {
+        return;
+    }
+    if( rxHead_ == rxTail_ )
+    {
+        return;
+    }
+    rxTail_ = rxTail_ + 1U;
+    lib::Guard<A> const guard(data_.gie);
+    // Frames left in the FIFOs by a full ring are moved by the interrupts re-enabled
+    enableRx(0, true);
+    enableRx(1, true);
+}
+
+template <class A>
+bool_t Can<A>::setListener(Listener* listener)
+{
+    if( !isConstructed() || config_.rxBuffer == NULLPTR )
+    {
+        return false;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    listener_ = listener;
+    return true;
+}
+
+template <class A>
+bool_t Can<A>::setMonitor(Monitor* monitor)
+{
+    if( !isConstructed() )
+    {
+        return false;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    monitor_ = monitor;
+    return true;
+}
+
+template <class A>
+typename Can<A>::State Can<A>::getState() const
+{
+    return state_;
+}
+
+template <class A>
+bool_t Can<A>::recover()
+{
+    if( !isConstructed() )
+    {
+        return false;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    if( can_->esr.bit.boff == 0U )
+    {
+        return false;
+    }
+    return restart();
+}
+
+template <class A>
+void Can<A>::getStatistics(Statistics& statistics) const
+{
+    // Each counter is read by one load
+    statistics.txFrames = statistics_.txFrames;
+    statistics.rxFrames = statistics_.rxFrames;
+    statistics.rxOverrun0 = statistics_.rxOverrun0;
+    statistics.rxOverrun1 = statistics_.rxOverrun1;
+    statistics.arbitrationLost = statistics_.arbitrationLost;
+    statistics.txErrors = statistics_.txErrors;
+    statistics.busErrors = statistics_.busErrors;
+    statistics.errorWarning = statistics_.errorWarning;
+    statistics.errorPassive = statistics_.errorPassive;
+    statistics.busOff = statistics_.busOff;
+    statistics.isrCycles = statistics_.isrCycles;
+    reg::Can::Esr const esr( can_->esr.value );
+    statistics.tec = esr.bit.tec;
+    statistics.rec = esr.bit.rec;
+    statistics.lec = esr.bit.lec;
+}
+
+template <class A>
+const CanBitTiming::Result& Can<A>::getBitTiming() const
+{
+    return timing_;
+}
+
+template <class A>
+size_t Can<A>::getPending() const
+{
+    size_t pending( txLength_ );
+    for(int32_t i(0); i<NUMBER_OF_MAILBOXES; i++)
+    {
+        if( isMailbox_[i] )
+        {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+template <class A>
+bool_t Can<A>::sleep()
+{
+    if( !isConstructed() )
+    {
+        return false;
+    }
+    {
+        lib::Guard<A> const guard(data_.gie);
+        if( getPending() != 0U )
+        {
+            return false;
+        }
+        reg::Can::Mcr mcr( can_->mcr.value );
+        mcr.bit.inrq = 0;
+        mcr.bit.sleep = 1;
+        can_->mcr.value = mcr.value;
+    }
+    // The sleep mode is entered after a frame being transmitted or received
+    for(int32_t i(0); i<REG_CAN_INAK_TIMEOUT; i++)
+    {
+        if( can_->msr.bit.slak != 0U )
+        {
+            return true;
+        }
+    }
+    // The request is cancelled not to enter the sleep mode later when the bus gets idle
+    lib::Guard<A> const guard(data_.gie);
+    can_->mcr.bit.sleep = 0;
+    return false;
+}
+
+template <class A>
+bool_t Can<A>::wakeUp()
+{
+    if( !isConstructed() )
+    {
+        return false;
+    }
+    {
+        lib::Guard<A> const guard(data_.gie);
+        can_->mcr.bit.sleep = 0;
+    }
+    for(int32_t i(0); i<REG_CAN_INAK_TIMEOUT; i++)
+    {
+        if( can_->msr.bit.slak == 0U )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class A>
+bool_t Can<A>::isSleeping() const
+{
+    return isConstructed() && can_->msr.bit.slak != 0U;
+}
+
+template <class A>
+void Can<A>::updateTime()
+{
+    if( !isConstructed() || !config_.isTimestamp )
+    {
+        return;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    uint32_t const cycles( data_.reg.dwt->cyccnt.value - rxCycles_ );
+    uint32_t const bits( cycles / cyclesPerBit_ );
+    // The cycles of a part of a bit time are kept not to lose them
+    rxTime_ += bits;
+    rxCycles_ += bits * cyclesPerBit_;
+}
+
+template <class A>
+int32_t Can<A>::getIndex() const
+{
+    return index_;
+}
+
+template <class A>
+bool_t Can<A>::isIndex(int32_t index)
+{
+    // The MCU is not a connectivity line device, thus it has CAN1 only
+    return index == Registers::INDEX_CAN1;
+}
+
+template <class A>
+bool_t Can<A>::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( can_ == NULLPTR )
+        {
+            break;
+        }
+        if( config_.txBuffer == NULLPTR || config_.txSize < static_cast<size_t>(NUMBER_OF_MAILBOXES) )
+        {
+            break;
+        }
+        if( config_.rxBuffer != NULLPTR && ( config_.rxSize == 0U || (config_.rxSize & (config_.rxSize - 1U)) != 0U ) )
+        {
+            break;
+        }
+        if( config_.recovery == RECOVERY_MANAGED )
+        {
+            if( config_.timer != Registers::INDEX_TIM6 && config_.timer != Registers::INDEX_TIM7 )
+            {
+                break;
+            }
+            if( config_.backOff < TIMER_TICK || config_.backOffMax < config_.backOff || config_.backOffMax / TIMER_TICK > TIMER_TICKS_MAX )
+            {
+                break;
+            }
+        }
+        if( !initializeBitTiming() )
+        {
+            break;
+        }
+        if( !initialize() )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+template <class A>
+bool_t Can<A>::initialize()
+{
+    txInt_ = createInterrupt(txHandler_, Interrupt<A>::EXCEPTION_USB_HP_CAN1_TX);
+    if( txInt_ == NULLPTR )
+    {
+        return false;
+    }
+    sceInt_ = createInterrupt(sceHandler_, Interrupt<A>::EXCEPTION_CAN1_SCE);
+    if( sceInt_ == NULLPTR )
+    {
+        return false;
+    }
+    if( config_.recovery == RECOVERY_MANAGED )
+    {
+        if( !initializeTimer() )
+        {
+            return false;
+        }
+    }
+    if( config_.rxBuffer != NULLPTR )
+    {
+        rxInt_[0] = createInterrupt(rx0Handler_, Interrupt<A>::EXCEPTION_USB_LP_CAN1_RX0);
+        rxInt_[1] = createInterrupt(rx1Handler_, Interrupt<A>::EXCEPTION_CAN1_RX1);
+        if( rxInt_[0] == NULLPTR || rxInt_[1] == NULLPTR )
+        {
+            return false;
+        }
+    }
+    if( !initializePins() )
+    {
+        return false;
+    }
+    {
+        lib::Guard<A> const guard(data_.gie);
+        enableClock(true);
+    }
+    if( !setInitialization(true) )
+    {
+        return false;
+    }
+    reg::Can::Mcr mcr(0);
+    mcr.bit.inrq = 1;
+    mcr.bit.txfp = 0;   // Transmit by identifier priority
+    mcr.bit.nart = 0;   // Retransmit until success, thus RQCP without TXOK means an abort
+    mcr.bit.ttcm = config_.isTimestamp ? 1 : 0;
+    mcr.bit.abom = ( config_.recovery == RECOVERY_AUTOMATIC ) ? 1 : 0;
+    mcr.bit.awum = config_.isAutoWakeUp ? 1 : 0;
+    can_->mcr.value = mcr.value;
+    reg::Can::Btr mode( timing_.btr );
+    mode.bit.lbkm = ( config_.mode == MODE_LOOPBACK || config_.mode == MODE_SILENT_LOOPBACK ) ? 1 : 0;
+    mode.bit.silm = ( config_.mode == MODE_SILENT || config_.mode == MODE_SILENT_LOOPBACK ) ? 1 : 0;
+    can_->btr.value = mode.value;
+    // The CPU clock is the APB1 clock multiplied by its prescaler, thus the ratio is exact
+    reg::Can::Btr const btr( timing_.btr );
+    uint32_t const ratio( static_cast<uint32_t>(data_.pll.getCpuClock() / data_.pll.getApb1Clock()) );
+    cyclesPerBit_ = ratio * (btr.bit.brp + 1U) * (btr.bit.ts1 + btr.bit.ts2 + 3U);
+    reg::Can::Ier ier(0);
+    ier.bit.tmeie = 1;
+    ier.bit.ewgie = 1;
+    ier.bit.epvie = 1;
+    ier.bit.bofie = 1;
+    ier.bit.errie = 1;
+    ier.bit.lecie = 1;
+    ier.bit.wkuie = 1;
+    if( config_.rxBuffer != NULLPTR )
+    {
+        ier.bit.fmpie0 = 1;
+        ier.bit.fovie0 = 1;
+        ier.bit.fmpie1 = 1;
+        ier.bit.fovie1 = 1;
+    }
+    can_->ier.value = ier.value;
+    if( !setInitialization(false) )
+    {
+        return false;
+    }
+    rxCycles_ = data_.reg.dwt->cyccnt.value;
+    txInt_->enable();
+    sceInt_->enable();
+    if( timInt_ != NULLPTR )
+    {
+        timInt_->enable();
+    }
+    if( config_.rxBuffer != NULLPTR )
+    {
+        rxInt_[0]->enable();
+        rxInt_[1]->enable();
+    }
+    return true;
+}
+
+template <class A>
+void Can<A>::deinitialize()
+{
+    if( txInt_ == NULLPTR )
+    {
+        return;
+    }
+    txInt_->disable();
+    if( sceInt_ != NULLPTR )
+    {
+        sceInt_->disable();
+    }
+    if( timInt_ != NULLPTR )
+    {
+        timInt_->disable();
+        tim_->cr1.value = 0;
+        tim_->dier.value = 0;
+        lib::Guard<A> const guard(data_.gie);
+        enableTimerClock(false);
+    }
+    for(int32_t i(0); i<2; i++)
+    {
+        if( rxInt_[i] != NULLPTR )
+        {
+            rxInt_[i]->disable();
+        }
+    }
+    can_->ier.value = 0;
+    // Reset the master, which also puts it to sleep mode
+    can_->mcr.bit.reset = 1;
+    {
+        lib::Guard<A> const guard(data_.gie);
+        enableClock(false);
+    }
+    for(int32_t i(0); i<2; i++)
+    {
+        delete rxInt_[i];
+        rxInt_[i] = NULLPTR;
+    }
+    delete timInt_;
+    timInt_ = NULLPTR;
+    delete sceInt_;
+    sceInt_ = NULLPTR;
+    delete txInt_;
+    txInt_ = NULLPTR;
+}
+
+template <class A>
+bool_t Can<A>::initializeBitTiming()
+{
+    int64_t const clock( data_.pll.getApb1Clock() );
+    if( config_.btr == 0U )
+    {
+        return CanBitTiming::calculate(clock, config_.bitRate, config_.samplePoint, timing_);
+    }
+    return CanBitTiming::getBitTiming(clock, config_.btr, timing_);
+}
+
+template <class A>
+bool_t Can<A>::initializeTimer()
+{
+    int32_t const exception( ( config_.timer == Registers::INDEX_TIM6 ) ? Interrupt<A>::EXCEPTION_TIM6 : Interrupt<A>::EXCEPTION_TIM7 );
+    timInt_ = createInterrupt(timHandler_, exception);
+    if( timInt_ == NULLPTR )
+    {
+        return false;
+    }
+    // Timers of APB1 are clocked twice faster than APB1 if APB1 prescaler is not 1
+    int64_t clock( data_.pll.getApb1Clock() );
+    if( clock != data_.pll.getAhbClock() )
+    {
+        clock *= 2;
+    }
+    int64_t const psc( clock / (1000000 / TIMER_TICK) - 1 );
+    if( psc < 0 || psc > 0x0000FFFF )
+    {
+        return false;
+    }
+    tim_ = data_.reg.tim[config_.timer];
+    lib::Guard<A> const guard(data_.gie);
+    enableTimerClock(true);
+    tim_->cr1.value = 0;
+    tim_->psc.value = static_cast<reg::Tim::Cnt::Value>(psc);
+    // Load the prescaler, and clear UIF set by the load not to start a recovery
+    tim_->egr.bit.ug = 1;
+    tim_->sr.value = 0;
+    tim_->dier.bit.uie = 1;
+    return true;
+}
+
+template <class A>
+bool_t Can<A>::setInitialization(bool_t enter)
+{
+    reg::Can::Mcr mcr( can_->mcr.value );
+    // Leave sleep mode as it keeps the controller from the initialization and normal modes
+    mcr.bit.sleep = 0;
+    mcr.bit.inrq = enter ? 1 : 0;
+    can_->mcr.value = mcr.value;
+    reg::Can::Msr::Value const inak( enter ? 1 : 0 );
+    // Leaving the initialization mode waits for 11 recessive bits on the bus
+    for(int32_t i(0); i<REG_CAN_INAK_TIMEOUT; i++)
+    {
+        if( can_->msr.bit.inak == inak )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class A>
+api::CpuInterrupt* Can<A>::createInterrupt(api::Runnable& handler, int32_t exception)
+{
+    api::CpuInterrupt* res( data_.ic.createResource(handler, exception) );
+    if( res != NULLPTR )
+    {
+        if( !res->isConstructed() )
+        {
+            delete res;
+            res = NULLPTR;
+        }
+    }
+    return res;
+}
+
+template <class A>
+void Can<A>::handleTx()
+{
+    static const reg::Can::Tsr::Value RQCP_MASK[NUMBER_OF_MAILBOXES] = {
+        reg::Can::Tsr::RQCP0_MASK,
+        reg::Can::Tsr::RQCP1_MASK,
+        reg::Can::Tsr::RQCP2_MASK
+    };
+    reg::Can::Tsr::Value const tsr( can_->tsr.value );
+    for(int32_t i(0); i<NUMBER_OF_MAILBOXES; i++)
+    {
+        if( (tsr & RQCP_MASK[i]) == 0U )
+        {
+            continue;
+        }
+        // Writing RQCP clears also TXOK, ALST and TERR of the mailbox
+        can_->tsr.value = RQCP_MASK[i];
+        if( !isMailbox_[i] )
+        {
+            continue;
+        }
+        isMailbox_[i] = false;
+        // TXOK, ALST and TERR are the bits next to RQCP of the mailbox
+        if( (tsr & (RQCP_MASK[i] << 2)) != 0U )
+        {
+            statistics_.arbitrationLost++;
+        }
+        if( (tsr & (RQCP_MASK[i] << 3)) != 0U )
+        {
+            statistics_.txErrors++;
+        }
+        if( (tsr & (RQCP_MASK[i] << 1)) != 0U )
+        {
+            statistics_.txFrames++;
+            backOff_ = config_.backOff;
+            Monitor* const monitor( monitor_ );
+            if( monitor != NULLPTR )
+            {
+                monitor->transmitted(mailbox_[i].frame, data_.reg.dwt->cyccnt.value - mailbox_[i].cycles);
+            }
+        }
+        else
+        {
+            // The mailbox has been aborted, and its frame goes back with its queueing order
+            push(mailbox_[i]);
+        }
+        if( abort_ == i )
+        {
+            abort_ = -1;
+        }
+    }
+    schedule();
+    updateState();
+}
+
+template <class A>
+void Can<A>::handleSce()
+{
+    reg::Can::Msr::Value const msr( can_->msr.value );
+    can_->msr.value = msr & (reg::Can::Msr::ERRI_MASK | reg::Can::Msr::WKUI_MASK);
+    if( (msr & reg::Can::Msr::ERRI_MASK) != 0U )
+    {
+        // The hardware updates the code on each error, and the code set by software
+        // tells the error has been counted if ERRI is raised for a state change
+        reg::Can::Esr esr( can_->esr.value );
+        if( esr.bit.lec != LEC_NO_ERROR && esr.bit.lec != LEC_SOFTWARE )
+        {
+            statistics_.busErrors++;
+            esr.value = 0;
+            esr.bit.lec = LEC_SOFTWARE;
+            can_->esr.value = esr.value;
+        }
+    }
+    if( (msr & reg::Can::Msr::WKUI_MASK) != 0U )
+    {
+        api::Runnable* const handler( config_.wakeUpHandler );
+        if( handler != NULLPTR )
+        {
+            handler->start();
+        }
+    }
+    updateState();
+}
+
+template <class A>
+void Can<A>::handleTimer()
+{
+    tim_->sr.value = 0;
+    if( can_->esr.bit.boff != 0U )
+    {
+        static_cast<void>( restart() );
+    }
+}
+
+template <class A>
+void Can<A>::updateState()
+{
+    reg::Can::Esr const esr( can_->esr.value );
+    State state( STATE_ERROR_ACTIVE );
+    if( esr.bit.boff != 0U )
+    {
+        state = STATE_BUS_OFF;
+    }
+    else if( esr.bit.epvf != 0U )
+    {
+        state = STATE_ERROR_PASSIVE;
+    }
+    else if( esr.bit.ewgf != 0U )
+    {
+        state = STATE_ERROR_WARNING;
+    }
+    if( state == state_ )
+    {
+        return;
+    }
+    state_ = state;
+    switch( state )
+    {
+        case STATE_ERROR_WARNING:
+        {
+            statistics_.errorWarning++;
+            break;
+        }
+        case STATE_ERROR_PASSIVE:
+        {
+            statistics_.errorPassive++;
+            break;
+        }
+        case STATE_BUS_OFF:
+        {
+            statistics_.busOff++;
+            if( tim_ != NULLPTR )
+            {
+                // The counter stops at the update event in one-pulse mode
+                tim_->cnt.value = 0;
+                tim_->arr.value = backOff_ / TIMER_TICK - 1U;
+                reg::Tim::Cr1 cr1(0);
+                cr1.bit.opm = 1;
+                cr1.bit.cen = 1;
+                tim_->cr1.value = cr1.value;
+                backOff_ = ( backOff_ <= config_.backOffMax / 2U ) ? backOff_ * 2U : config_.backOffMax;
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    api::Runnable* const handler( config_.stateHandler[state] );
+    if( handler != NULLPTR )
+    {
+        handler->start();
+    }
+}
+
+template <class A>
+bool_t Can<A>::restart()
+{
+    if( !setInitialization(true) )
+    {
+        return false;
+    }
+    // The hardware leaves bus-off after 128 occurrences of 11 recessive bits, thus it is not waited
+    reg::Can::Mcr mcr( can_->mcr.value );
+    mcr.bit.inrq = 0;
+    can_->mcr.value = mcr.value;
+    return true;
+}
+
+template <class A>
+void Can<A>::handleRx0()
+{
+    handleRx(0);
+}
+
+template <class A>
+void Can<A>::handleRx1()
+{
+    handleRx(1);
+}
+
+template <class A>
+void Can<A>::handleRx(int32_t fifo)
+{
+    // Both RX interrupts have one priority, thus they do not preempt each other to put frames
+    uint32_t const cycles( data_.reg.dwt->cyccnt.value );
+    uint32_t const mask( static_cast<uint32_t>(config_.rxSize) - 1U );
+    if( can_->rfxr[fifo].bit.fovrx != 0U )
+    {
+        can_->rfxr[fifo].value = reg::Can::RfXr::FOVR_MASK;
+        if( fifo == 0 )
+        {
+            statistics_.rxOverrun0++;
+        }
+        else
+        {
+            statistics_.rxOverrun1++;
+        }
+    }
+    while( can_->rfxr[fifo].bit.fmpx != 0U )
+    {
+        uint32_t const head( rxHead_ );
+        bool_t const isFull( head - rxTail_ == static_cast<uint32_t>(config_.rxSize) );
+        Listener* const listener( listener_ );
+        if( isFull && listener == NULLPTR )
+        {
+            enableRx(fifo, false);
+            break;
+        }
+        // A frame is read to the spare slot if the ring is full as a listener may consume it
+        RxFrame& slot( isFull ? rxSpare_ : config_.rxBuffer[head & mask] );
+        reg::Can::Rx const& rx( can_->rx[fifo] );
+        reg::Can::Rx::RiXr const rixr( rx.rixr.value );
+        reg::Can::Rx::RdtXr const rdtxr( rx.rdtxr.value );
+        uint32_t const low( rx.rdlxr.value );
+        uint32_t const high( rx.rdhxr.value );
+        CanFrame& frame( slot.frame );
+        if( rixr.bit.ide != 0U )
+        {
+            frame.id = (static_cast<uint32_t>(rixr.bit.stid) << 18) | rixr.bit.exid;
+            frame.isExtended = true;
+        }
+        else
+        {
+            frame.id = rixr.bit.stid;
+            frame.isExtended = false;
+        }
+        frame.isRemote = rixr.bit.rtr != 0U;
+        // A DLC above 8 means 8 data bytes
+        frame.size = (rdtxr.bit.dlc > CanFrame::DATA_SIZE) ? CanFrame::DATA_SIZE : static_cast<uint8_t>(rdtxr.bit.dlc);
+        for(int32_t i(0); i<4; i++)
+        {
+            frame.data[i] = static_cast<uint8_t>(low >> (i * 8));
+            frame.data[i + 4] = static_cast<uint8_t>(high >> (i * 8));
+        }
+        slot.time = config_.isTimestamp ? extendTime(rdtxr.bit.time, cycles) : 0U;
+        slot.fifo = fifo;
+        slot.fmi = rdtxr.bit.fmi;
+        Monitor* const monitor( monitor_ );
+        if( listener != NULLPTR && listener->accept(slot) )
+        {
+            can_->rfxr[fifo].value = reg::Can::RfXr::RFOM_MASK;
+            statistics_.rxFrames++;
+            if( monitor != NULLPTR )
+            {
+                monitor->received(slot);
+            }
+            continue;
+        }
+        if( isFull )
+        {
+            // The frame is left in the FIFO to be read again when a slot is released
+            enableRx(fifo, false);
+            break;
+        }
+        if( monitor != NULLPTR )
+        {
+            monitor->received(slot);
+        }
+        can_->rfxr[fifo].value = reg::Can::RfXr::RFOM_MASK;
+        // The slot is given to the consumer after it is written
+        rxHead_ = head + 1U;
+        statistics_.rxFrames++;
+    }
+    updateState();
+}
+
+template <class A>
+uint64_t Can<A>::extendTime(uint32_t stamp, uint32_t cycles)
+{
+    // The stamp is taken which is the nearest to the time estimated by the CPU clock cycles
+    uint64_t const estimate( rxTime_ + (cycles - rxCycles_) / cyclesPerBit_ );
+    int16_t const delta( static_cast<int16_t>(static_cast<uint16_t>(stamp - static_cast<uint32_t>(estimate))) );
+    rxTime_ = estimate + static_cast<int64_t>(delta);
+    rxCycles_ = cycles;
+    return rxTime_;
+}
+
+template <class A>
+void Can<A>::enableRx(int32_t fifo, bool_t enable)
+{
+    reg::Can::Ier::Value const value( enable ? 1 : 0 );
+    if( fifo == 0 )
+    {
+        can_->ier.bit.fmpie0 = value;
+    }
+    else
+    {
+        can_->ier.bit.fmpie1 = value;
+    }
+}
+
+template <class A>
+void Can<A>::schedule()
+{
+    for(int32_t i(0); i<NUMBER_OF_MAILBOXES && txLength_ != 0U; i++)
+    {
+        if( isMailbox_[i] )
+        {
+            continue;
+        }
+        if( isLoaded(config_.txBuffer[0].arbitration) )
+        {
+            return;
+        }
+        TxEntry entry;
+        pop(entry);
+        load(i, entry);
+    }
+    if( txLength_ == 0U || abort_ != -1 )
+    {
+        return;
+    }
+    int32_t lowest( -1 );
+    for(int32_t i(0); i<NUMBER_OF_MAILBOXES; i++)
+    {
+        if( !isMailbox_[i] )
+        {
+            return;
+        }
+        if( lowest == -1 || isHigher(mailbox_[lowest], mailbox_[i]) )
+        {
+            lowest = i;
+        }
+    }
+    // Frames of one arbitration field are not reordered, thus only a higher one preempts
+    if( config_.txBuffer[0].arbitration < mailbox_[lowest].arbitration && !isLoaded(config_.txBuffer[0].arbitration) )
+    {
+        static const reg::Can::Tsr::Value ABRQ_MASK[NUMBER_OF_MAILBOXES] = {
+            reg::Can::Tsr::ABRQ0_MASK,
+            reg::Can::Tsr::ABRQ1_MASK,
+            reg::Can::Tsr::ABRQ2_MASK
+        };
+        abort_ = lowest;
+        can_->tsr.value = ABRQ_MASK[lowest];
+    }
+}
+
+template <class A>
+void Can<A>::load(int32_t mailbox, const TxEntry& entry)
+{
+    CanFrame const& frame( entry.frame );
+    reg::Can::Tx& tx( can_->tx[mailbox] );
+    reg::Can::Tx::TdtXr tdtxr(0);
+    tdtxr.bit.dlc = frame.size;
+    tx.tdtxr.value = tdtxr.value;
+    tx.tdlxr.value = static_cast<uint32_t>(frame.data[0])
+                   | (static_cast<uint32_t>(frame.data[1]) << 8)
+                   | (static_cast<uint32_t>(frame.data[2]) << 16)
+                   | (static_cast<uint32_t>(frame.data[3]) << 24);
+    tx.tdhxr.value = static_cast<uint32_t>(frame.data[4])
+                   | (static_cast<uint32_t>(frame.data[5]) << 8)
+                   | (static_cast<uint32_t>(frame.data[6]) << 16)
+                   | (static_cast<uint32_t>(frame.data[7]) << 24);
+    reg::Can::Tx::TiXr tixr(0);
+    if( frame.isExtended )
+    {
+        tixr.bit.stid = frame.id >> 18;
+        tixr.bit.exid = frame.id & 0x0003FFFFU;
+        tixr.bit.ide = 1;
+    }
+    else
+    {
+        tixr.bit.stid = frame.id;
+    }
+    tixr.bit.rtr = frame.isRemote ? 1 : 0;
+    tixr.bit.txrq = 1;
+    mailbox_[mailbox] = entry;
+    isMailbox_[mailbox] = true;
+    // The transmission is requested by the identifier register written last
+    tx.tixr.value = tixr.value;
+}
+
+template <class A>
+bool_t Can<A>::isLoaded(uint32_t arbitration) const
+{
+    for(int32_t i(0); i<NUMBER_OF_MAILBOXES; i++)
+    {
+        if( isMailbox_[i] && mailbox_[i].arbitration == arbitration )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class A>
+void Can<A>::push(const TxEntry& entry)
+{
+    TxEntry* const heap( config_.txBuffer );
+    size_t index( txLength_++ );
+    while( index != 0U )
+    {
+        size_t const parent( (index - 1U) >> 1 );
+        if( !isHigher(entry, heap[parent]) )
+        {
+            break;
+        }
+        heap[index] = heap[parent];
+        index = parent;
+    }
+    heap[index] = entry;
+}
+
+template <class A>
+void Can<A>::pop(TxEntry& entry)
+{
+    TxEntry* const heap( config_.txBuffer );
+    entry = heap[0];
+    size_t const length( --txLength_ );
+    if( length == 0U )
+    {
+        return;
+    }
+    TxEntry const& last( heap[length] );
+    size_t index( 0U );
+    while( true )
+    {
+        size_t child( (index << 1) + 1U );
+        if( child >= length )
+        {
+            break;
+        }
+        if( child + 1U < length && isHigher(heap[child + 1U], heap[child]) )
+        {
+            child++;
+        }
+        if( !isHigher(heap[child], last) )
+        {
+            break;
+        }
+        heap[index] = heap[child];
+        index = child;
+    }
+    heap[index] = last;
+}
+
+template <class A>
+bool_t Can<A>::isHigher(const TxEntry& entry1, const TxEntry& entry2)
+{
+    if( entry1.arbitration != entry2.arbitration )
+    {
+        return entry1.arbitration < entry2.arbitration;
+    }
+    // The queueing order wraps, thus it is compared by the sign of the difference
+    return static_cast<int32_t>(entry1.sequence - entry2.sequence) < 0;
+}
+
+template <class A>
+void Can<A>::enableClock(bool_t enable)
+{
+    data_.reg.rcc->apb1enr.bit.can1en = enable ? 1 : 0;
+}
+
+template <class A>
+void Can<A>::enableTimerClock(bool_t enable)
+{
+    if( config_.timer == Registers::INDEX_TIM6 )
+    {
+        data_.reg.rcc->apb1enr.bit.tim6en = enable ? 1 : 0;
+    }
+    else
+    {
+        data_.reg.rcc->apb1enr.bit.tim7en = enable ? 1 : 0;
+    }
+}
+
+template <class A>
+bool_t Can<A>::initializePins()
+{
+    // CAN1 is not remapped, thus its RX is PA11 and TX is PA12
+    if( !data_.gpio.setMode(Gpio::Pin(Registers::INDEX_GPIOA, 12), Gpio::MODE_ALTERNATE_PUSH_PULL) )
+    {
+        return false;
+    }
+    if( !data_.gpio.setMode(Gpio::Pin(Registers::INDEX_GPIOA, 11), Gpio::MODE_INPUT_FLOATING) )
+    {
+        return false;
+    }
+    return true;
+}
+
+template <class A>
+Can<A>::TxEntry::TxEntry()
+    : frame()
+    , arbitration(0)
+    , sequence(0)
+    , cycles(0) {
+}
+
+template <class A>
+Can<A>::RxFrame::RxFrame()
+    : frame()
+    , time(0)
+    , fifo(0)
+    , fmi(0) {
+}
+
+template <class A>
+Can<A>::Config::Config()
+    : bitRate(500000)
+    , samplePoint(875)
+    , btr(0)
+    , txBuffer(NULLPTR)
+    , txSize(0)
+    , rxBuffer(NULLPTR)
+    , rxSize(0)
+    , isTimestamp(false)
+    , mode(MODE_NORMAL)
+    , recovery(RECOVERY_AUTOMATIC)
+    , timer(Registers::INDEX_TIM7)
+    , backOff(10000)
+    , backOffMax(1000000)
+    , stateHandler()
+    , isAutoWakeUp(true)
+    , wakeUpHandler(NULLPTR) {
+}
+
+template <class A>
+Can<A>::Statistics::Statistics()
+    : txFrames(0)
+    , rxFrames(0)
+    , rxOverrun0(0)
+    , rxOverrun1(0)
+    , arbitrationLost(0)
+    , txErrors(0)
+    , busErrors(0)
+    , errorWarning(0)
+    , errorPassive(0)
+    , busOff(0)
+    , tec(0)
+    , rec(0)
+    , lec(0)
+    , isrCycles(0) {
+}
+
+template <class A>
+Can<A>::Data::Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, PllController& apll)
+    : reg(areg)
+    , gie(agie)
+    , ic(aic)
+    , gpio(agpio)
+    , pll(apll) {
+}
+
+template <class A>
+Can<A>::Handler::Handler(Can& can, Function function)
+    : api::Runnable()
+    , can_( can )
+    , function_( function ) {
+}
+
+template <class A>
+Can<A>::Handler::~Handler()
+{
+}
+
+template <class A>
+bool_t Can<A>::Handler::isConstructed() const
+{
+    return true;
+}
+
+template <class A>
+void Can<A>::Handler::start()
+{
+    uint32_t const begin( can_.data_.reg.dwt->cyccnt.value );
+    (can_.*function_)();
+    can_.statistics_.isrCycles += can_.data_.reg.dwt->cyccnt.value - begin;
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CAN_HPP_
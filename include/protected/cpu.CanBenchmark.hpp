@@ -0,0 +1,188 @@
+/**
+ * @file      cpu.CanBenchmark.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANBENCHMARK_HPP_
+#define CPU_CANBENCHMARK_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "cpu.CycleCounter.hpp"
+#include "cpu.CanController.hpp"
+#include "cpu.CanFilter.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanBenchmark
+ * @brief CAN driver throughput benchmark.
+ *
+ * The benchmark keeps the TX priority queue full of frames and reads them back from the RX ring,
+ * thus a CAN resource in a loopback mode transmits frames back-to-back. The identifiers of frames
+ * rise in order of queueing, thus the frames are transmitted in this order, and all three TX
+ * mailboxes are kept loaded as frames of one identifier are never loaded to two mailboxes at once.
+ * The queue drains once the identifiers wrap to zero. Each frame carries the CPU clock cycles of
+ * its queueing and its sequence number, thus the latency from transmit() to receive() is
+ * measured for each frame and lost or reordered frames are counted.
+ *
+ * @note The CAN resource must be in a loopback mode and receive frames, and the benchmark sets its filter.
+ * @note A run must be shorter than the period of the CPU clock cycle counter.
+ */
+class CanBenchmark : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Number of standard identifiers of benchmark frames starting from zero.
+     */
+    static const uint32_t NUMBER_OF_IDS = 0x800;
+
+    /**
+     * @struct Result
+     * @brief Benchmark result.
+     */
+    struct Result
+    {
+        /**
+         * @brief Constructor.
+         */
+        Result();
+
+        /**
+         * @brief Number of received frames.
+         */
+        uint32_t frames;
+
+        /**
+         * @brief Number of frames not received or received out of order.
+         */
+        uint32_t errors;
+
+        /**
+         * @brief CPU clock cycles of the run.
+         */
+        uint32_t cycles;
+
+        /**
+         * @brief Received frames per second.
+         */
+        uint32_t framesPerSecond;
+
+        /**
+         * @brief CPU clock cycles of the CAN interrupt handlers per frame.
+         */
+        uint32_t isrCyclesPerFrame;
+
+        /**
+         * @brief Average CPU clock cycles from transmit() to receive() of a frame.
+         */
+        uint32_t latencyAverage;
+
+        /**
+         * @brief Maximal CPU clock cycles from transmit() to receive() of a frame.
+         */
+        uint32_t latencyMax;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param can   A CAN resource.
+     * @param cyc   CPU clock cycle counter.
+     * @param clock CPU clock in Hz.
+     */
+    CanBenchmark(CanController::Resource& can, CycleCounter& cyc, int64_t clock);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CanBenchmark();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Runs the benchmark.
+     *
+     * @param frames Number of frames to transmit.
+     * @param result The result.
+     * @return True if all frames are received in order.
+     */
+    bool_t run(uint32_t frames, Result& result);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Reads a little-endian word of frame data.
+     *
+     * @param data Bytes of the word.
+     * @return The word.
+     */
+    static uint32_t getWord(const uint8_t* data);
+
+    /**
+     * @brief Writes a little-endian word to frame data.
+     *
+     * @param data  Bytes of the word.
+     * @param value The word.
+     */
+    static void setWord(uint8_t* data, uint32_t value);
+
+    /**
+     * @brief Divider of the CPU clock to get the cycles without a received frame which stop a run.
+     */
+    static const uint32_t TIMEOUT_DIVIDER = 10;
+
+    /**
+     * @brief CAN resource.
+     */
+    CanController::Resource& can_;
+
+    /**
+     * @brief CPU clock cycle counter.
+     */
+    CycleCounter& cyc_;
+
+    /**
+     * @brief CPU clock in Hz.
+     */
+    int64_t clock_;
+
+    /**
+     * @brief Filter term memory.
+     */
+    CanFilter::Term term_[1];
+
+    /**
+     * @brief Filter of benchmark frames.
+     */
+    CanFilter filter_;
+
+    /**
+     * @brief Filter rule of benchmark frames.
+     */
+    CanFilter::Rule rule_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANBENCHMARK_HPP_
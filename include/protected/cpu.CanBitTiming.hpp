@@ -0,0 +1,119 @@
+/**
+ * @file      cpu.CanBitTiming.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANBITTIMING_HPP_
+#define CPU_CANBITTIMING_HPP_
+
+#include "cpu.Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanBitTiming
+ * @brief CAN bit timing calculator.
+ *
+ * A CAN bit is the synchronization segment of one time quantum, then segment 1 of TS1 + 1 quanta
+ * and segment 2 of TS2 + 1 quanta, where the bit is sampled between the segments. The quantum is
+ * (BRP + 1) periods of PCLK1. The calculator takes the prescaler and the number of quanta of the
+ * least bit rate error, then the nearest sample point, then the most quanta in a bit.
+ */
+class CanBitTiming
+{
+
+public:
+
+    /**
+     * @struct Result
+     * @brief Calculated bit timing.
+     */
+    struct Result
+    {
+        /**
+         * @brief Constructor.
+         */
+        Result();
+
+        /**
+         * @brief BTR value of the bit timing fields.
+         */
+        uint32_t btr;
+
+        /**
+         * @brief Achieved bit rate.
+         */
+        int64_t bitRate;
+
+        /**
+         * @brief Error of the achieved bit rate in parts per million.
+         */
+        int32_t ppm;
+
+        /**
+         * @brief Achieved sample point in per mille of a bit.
+         */
+        int32_t samplePoint;
+    };
+
+    /**
+     * @brief Calculates BTR value.
+     *
+     * @param clock       PCLK1 in Hz.
+     * @param bitRate     A bit rate to achieve.
+     * @param samplePoint A sample point to achieve in per mille of a bit.
+     * @param result      A calculated result.
+     * @return True if the bit rate is achievable.
+     */
+    static bool_t calculate(int64_t clock, int64_t bitRate, int32_t samplePoint, Result& result);
+
+    /**
+     * @brief Calculates the bit timing of BTR value.
+     *
+     * @param clock  PCLK1 in Hz.
+     * @param btr    A BTR value.
+     * @param result A calculated result, which error is zero.
+     * @return True if BTR value is correct.
+     */
+    static bool_t getBitTiming(int64_t clock, uint32_t btr, Result& result);
+
+private:
+
+    /**
+     * @brief Maximal prescaler.
+     */
+    static const int64_t BRP_MAX = 1024;
+
+    /**
+     * @brief Maximal quanta of segment 1.
+     */
+    static const int32_t SEGMENT1_MAX = 16;
+
+    /**
+     * @brief Maximal quanta of segment 2.
+     */
+    static const int32_t SEGMENT2_MAX = 8;
+
+    /**
+     * @brief Minimal quanta of a bit recommended by ISO 11898-1 for resynchronization.
+     */
+    static const int32_t QUANTA_MIN = 8;
+
+    /**
+     * @brief Maximal quanta of a bit.
+     */
+    static const int32_t QUANTA_MAX = 1 + SEGMENT1_MAX + SEGMENT2_MAX;
+
+    /**
+     * @brief Maximal quanta of resynchronization jump width.
+     */
+    static const int32_t SJW_MAX = 4;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANBITTIMING_HPP_
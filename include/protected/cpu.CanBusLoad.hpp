@@ -0,0 +1,365 @@
+/**
+ * @file      cpu.CanBusLoad.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANBUSLOAD_HPP_
+#define CPU_CANBUSLOAD_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.CycleCounter.hpp"
+#include "cpu.CanController.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanBusLoad
+ * @brief CAN bus load and TX latency estimator.
+ *
+ * The estimator is the monitor of a CAN resource. Bits of each transmitted and received frame are
+ * counted as they are on the bus, which are the bits from SOF to the interframe space and the stuff
+ * bits of the frame, which are counted exactly from its identifier, data and CRC. The bits are
+ * summed in buckets of a period of time, which form a ring, thus the load of the bus is given over
+ * a sliding window of a number of last periods, and the peak load of a period is kept.
+ *
+ * The latency of transmitted frames, which is the time from transmit() to the TX interrupt of the
+ * transmission, is collected for given identifiers to a histogram of power of two microseconds.
+ *
+ * @note Only frames passed by the acceptance filter are seen on reception, thus the filter should
+ *       accept all frames to estimate the load of the bus. A frame transmitted in a loopback mode
+ *       is counted twice.
+ */
+class CanBusLoad : public NonCopyable<NoAllocator>, public CanController::Resource::Monitor
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Number of latency histogram bins.
+     */
+    static const int32_t NUMBER_OF_BINS = 16;
+
+    /**
+     * @struct Latency
+     * @brief TX latency of an identifier.
+     */
+    struct Latency
+    {
+        /**
+         * @brief Constructor of an empty record.
+         */
+        Latency();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param aid         An identifier.
+         * @param aisExtended Extended identifier.
+         */
+        Latency(uint32_t aid, bool_t aisExtended);
+
+        /**
+         * @brief Identifier.
+         */
+        uint32_t id;
+
+        /**
+         * @brief Extended identifier.
+         */
+        bool_t isExtended;
+
+        /**
+         * @brief Number of transmitted frames.
+         */
+        uint32_t frames;
+
+        /**
+         * @brief Sum of latencies in microseconds.
+         */
+        uint64_t sum;
+
+        /**
+         * @brief Maximal latency in microseconds.
+         */
+        uint32_t max;
+
+        /**
+         * @brief Numbers of frames of latencies in microseconds from 2^i to 2^(i+1), where the first and the last bins are open.
+         */
+        uint32_t histogram[NUMBER_OF_BINS];
+    };
+
+    /**
+     * @struct Config
+     * @brief Bus load estimator configuration.
+     */
+    struct Config
+    {
+        /**
+         * @brief Constructor of default configuration.
+         */
+        Config();
+
+        /**
+         * @brief Period of a bucket in microseconds.
+         */
+        uint32_t period;
+
+        /**
+         * @brief Bucket memory.
+         */
+        uint32_t* buckets;
+
+        /**
+         * @brief Number of buckets, which is more than the number of periods of the longest window.
+         */
+        size_t numberOfBuckets;
+
+        /**
+         * @brief Latency records of identifiers, or a null pointer.
+         */
+        Latency* latencies;
+
+        /**
+         * @brief Number of latency records.
+         */
+        size_t numberOfLatencies;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param can    A CAN resource.
+     * @param gie    Global interrupt enable controller.
+     * @param cyc    CPU clock cycle counter.
+     * @param clock  CPU clock in Hz.
+     * @param config Configuration.
+     */
+    CanBusLoad(CanController::Resource& can, api::Guard& gie, CycleCounter& cyc, int64_t clock, const Config& config);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CanBusLoad();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Returns the bus load over last periods.
+     *
+     * @param periods Number of last complete periods.
+     * @return The load in per mille, or zero if the periods are out of the buckets.
+     */
+    uint32_t getLoad(size_t periods);
+
+    /**
+     * @brief Returns the maximal bus load of a period.
+     *
+     * @return The load in per mille.
+     */
+    uint32_t getPeak();
+
+    /**
+     * @brief Returns number of frames of the bus.
+     *
+     * @return Number of frames.
+     */
+    uint32_t getFrames() const;
+
+    /**
+     * @brief Returns number of transmitted frames of identifiers without a latency record.
+     *
+     * @return Number of frames.
+     */
+    uint32_t getUnrecorded() const;
+
+    /**
+     * @brief Copies the latency record of an identifier.
+     *
+     * @param index   A record index.
+     * @param latency The record.
+     * @return True if the record is copied.
+     */
+    bool_t getLatency(size_t index, Latency& latency) const;
+
+    /**
+     * @brief Clears the latency records and the peak load.
+     */
+    void reset();
+
+    /**
+     * @brief Moves the current bucket to the current period.
+     *
+     * The periods are counted by a 32 bits CPU clock cycle counter, thus the estimator is called
+     * at least every 2^32 CPU clock cycles, which is about 59 seconds at 72 MHz, like from a
+     * system tick, if frames may be not transmitted and received, and the load is not got that long.
+     */
+    void update();
+
+    /**
+     * @copydoc eoos::cpu::Can::Monitor::received(const RxFrame&)
+     */
+    virtual void received(const CanController::Resource::RxFrame& frame);
+
+    /**
+     * @copydoc eoos::cpu::Can::Monitor::transmitted(const CanFrame&, uint32_t)
+     */
+    virtual void transmitted(const CanFrame& frame, uint32_t cycles);
+
+    /**
+     * @brief Returns number of bits of a frame on the bus.
+     *
+     * @param frame A frame.
+     * @return Number of bits from SOF to the end of the interframe space with the stuff bits.
+     */
+    static uint32_t getBits(const CanFrame& frame);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @struct Stream
+     * @brief Bits of a frame on the bus.
+     */
+    struct Stream
+    {
+        /**
+         * @brief Constructor.
+         */
+        Stream();
+
+        /**
+         * @brief CRC of the bits put.
+         */
+        uint32_t crc;
+
+        /**
+         * @brief Number of the bits put and their stuff bits.
+         */
+        uint32_t bits;
+
+        /**
+         * @brief Number of last bits of one level.
+         */
+        uint32_t run;
+
+        /**
+         * @brief Last bit level.
+         */
+        uint32_t level;
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Adds bits of a frame to the current bucket.
+     *
+     * @param frame A frame.
+     */
+    void count(const CanFrame& frame);
+
+    /**
+     * @brief Moves the current bucket to the current period.
+     */
+    void advance();
+
+    /**
+     * @brief Returns the load of bits over periods.
+     *
+     * @param bits    Number of bits.
+     * @param periods Number of periods.
+     * @return The load in per mille.
+     */
+    uint32_t getLoad(uint64_t bits, size_t periods) const;
+
+    /**
+     * @brief Puts stuffed bits of a frame.
+     *
+     * @param stream The bits of the frame.
+     * @param value  Bits to put from the MSB.
+     * @param number Number of bits.
+     * @param isCrc  Bits are covered by CRC.
+     */
+    static void put(Stream& stream, uint32_t value, int32_t number, bool_t isCrc);
+
+    /**
+     * @brief Number of bits after CRC, which are CRC and ACK delimiters, ACK slot, EOF and the interframe space.
+     */
+    static const uint32_t TAIL_BITS = 13;
+
+    /**
+     * @brief CAN resource.
+     */
+    CanController::Resource& can_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief CPU clock cycle counter.
+     */
+    CycleCounter& cyc_;
+
+    /**
+     * @brief Configuration.
+     */
+    Config config_;
+
+    /**
+     * @brief CPU clock cycles per microsecond.
+     */
+    uint32_t cyclesPerUs_;
+
+    /**
+     * @brief CPU clock cycles of a period.
+     */
+    uint32_t periodCycles_;
+
+    /**
+     * @brief Index of the current bucket.
+     */
+    uint32_t bucket_;
+
+    /**
+     * @brief CPU clock cycles when the current period has begun.
+     */
+    uint32_t begin_;
+
+    /**
+     * @brief Maximal bits of a period.
+     */
+    uint32_t peak_;
+
+    /**
+     * @brief Number of frames.
+     */
+    uint32_t volatile frames_;
+
+    /**
+     * @brief Number of transmitted frames without a latency record.
+     */
+    uint32_t volatile unrecorded_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANBUSLOAD_HPP_
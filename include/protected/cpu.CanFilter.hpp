@@ -0,0 +1,458 @@
+/**
+ * @file      cpu.CanFilter.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANFILTER_HPP_
+#define CPU_CANFILTER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "cpu.CanFrame.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanFilter
+ * @brief CAN acceptance filter compiler.
+ *
+ * Rules are joined to sorted disjoint ranges, which are split to terms of an identifier value and a mask, which
+ * are aligned power of two blocks of a range. The terms are put to filter banks as tightly as
+ * possible: single standard identifiers are put four to a 16 bits list bank, standard masks two
+ * to a 16 bits mask bank, single extended identifiers two to a 32 bits list bank, and an extended
+ * mask to a 32 bits mask bank. If the terms need more banks than given, two terms of one format
+ * are merged to one mask, which accepts the least number of identifiers not requested per bank
+ * space saved, one by one, and the terms after the merges which fit and accept the least
+ * identifiers not requested are taken, thus more banks never accept more. Identifiers accepted
+ * are counted by the union of the terms, as merged terms may overlap others. The banks are
+ * assigned to FIFO 0 and FIFO 1 by number of requested identifiers.
+ *
+ * A filter element which accepts only requested identifiers is exact, thus frames matched by it
+ * need not be filtered by software.
+ *
+ * @note Remote frames are not accepted.
+ */
+class CanFilter : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Number of filter banks of the MCU.
+     */
+    static const int32_t NUMBER_OF_BANKS = 14;
+
+    /**
+     * @struct Rule
+     * @brief Range of identifiers to accept.
+     */
+    struct Rule
+    {
+        /**
+         * @brief Constructor of an empty rule.
+         */
+        Rule();
+
+        /**
+         * @brief Constructor of one identifier rule.
+         *
+         * @param aid         An identifier.
+         * @param aisExtended Extended identifier.
+         */
+        Rule(uint32_t aid, bool_t aisExtended);
+
+        /**
+         * @brief Constructor of a range rule.
+         *
+         * @param afirst      The first identifier.
+         * @param alast       The last identifier.
+         * @param aisExtended Extended identifiers.
+         */
+        Rule(uint32_t afirst, uint32_t alast, bool_t aisExtended);
+
+        /**
+         * @brief The first identifier.
+         */
+        uint32_t first;
+
+        /**
+         * @brief The last identifier.
+         */
+        uint32_t last;
+
+        /**
+         * @brief Extended identifiers.
+         */
+        bool_t isExtended;
+    };
+
+    /**
+     * @struct Term
+     * @brief Identifier value and mask compiled from rules.
+     */
+    struct Term
+    {
+        /**
+         * @brief Constructor.
+         */
+        Term();
+
+        /**
+         * @brief Identifier value.
+         */
+        uint32_t value;
+
+        /**
+         * @brief Identifier mask of bits to be matched.
+         */
+        uint32_t mask;
+
+        /**
+         * @brief Number of requested identifiers the term accepts.
+         */
+        uint32_t requested;
+
+        /**
+         * @brief Extended identifiers.
+         */
+        bool_t isExtended;
+    };
+
+    /**
+     * @struct Bank
+     * @brief Filter bank.
+     */
+    struct Bank
+    {
+        /**
+         * @brief Constructor.
+         */
+        Bank();
+
+        /**
+         * @brief Identifier list mode, otherwise identifier mask mode.
+         */
+        bool_t isList;
+
+        /**
+         * @brief Single 32 bits scale, otherwise dual 16 bits scale.
+         */
+        bool_t isWide;
+
+        /**
+         * @brief FIFO index.
+         */
+        int32_t fifo;
+
+        /**
+         * @brief Filter bank register 1 value.
+         */
+        uint32_t fr1;
+
+        /**
+         * @brief Filter bank register 2 value.
+         */
+        uint32_t fr2;
+
+        /**
+         * @brief Number of filter elements.
+         */
+        int32_t elements;
+
+        /**
+         * @brief Bits of exact filter elements.
+         */
+        uint32_t exact;
+
+        /**
+         * @brief Number of requested identifiers.
+         */
+        uint32_t weight;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param buffer Memory for terms.
+     * @param size   Number of terms of the memory.
+     */
+    CanFilter(Term* buffer, size_t size);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CanFilter();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Compiles rules to filter banks.
+     *
+     * @param rules  Rules, which are referenced until next compilation.
+     * @param number Number of rules.
+     * @param banks  Maximal number of filter banks.
+     * @return True if compiled.
+     */
+    bool_t compile(const Rule* rules, size_t number, int32_t banks);
+
+    /**
+     * @brief Returns number of compiled filter banks.
+     *
+     * @return Number of banks.
+     */
+    int32_t getBanks() const;
+
+    /**
+     * @brief Returns a compiled filter bank.
+     *
+     * @param index A bank index.
+     * @return The bank.
+     */
+    const Bank& getBank(int32_t index) const;
+
+    /**
+     * @brief Returns number of identifiers accepted but not requested.
+     *
+     * @return Number of identifiers.
+     */
+    uint32_t getOverAccepted() const;
+
+    /**
+     * @brief Tests if a filter element accepts only requested identifiers.
+     *
+     * @param fifo A FIFO index.
+     * @param fmi  A filter match index of a received frame.
+     * @return True if the element is exact.
+     */
+    bool_t isExact(int32_t fifo, uint32_t fmi) const;
+
+    /**
+     * @brief Tests if a frame is requested by the rules.
+     *
+     * @param frame A frame.
+     * @return True if it is requested.
+     */
+    bool_t isRequested(const CanFrame& frame) const;
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @enum Kind
+     * @brief Kinds of terms by filter elements they use.
+     */
+    enum Kind
+    {
+        KIND_EXTENDED_MASK = 0,
+        KIND_EXTENDED_ID,
+        KIND_STANDARD_MASK,
+        KIND_STANDARD_ID,
+        NUMBER_OF_KINDS
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Splits the rules to terms.
+     *
+     * @return True if the rules are valid and the terms fit the memory.
+     */
+    bool_t split();
+
+    /**
+     * @brief Returns a range of the rules joined.
+     *
+     * @param isExtended Extended format.
+     * @param from       An identifier the range is searched from.
+     * @param first      The first identifier of the range.
+     * @param last       The last identifier of the range.
+     * @return True if the range is found.
+     */
+    bool_t getRange(bool_t isExtended, uint32_t from, uint32_t& first, uint32_t& last) const;
+
+    /**
+     * @brief Merges two terms of one format which accept the least identifiers not requested per bank space saved.
+     *
+     * @return True if two terms are merged.
+     */
+    bool_t merge();
+
+    /**
+     * @brief Returns number of filter banks for the terms.
+     *
+     * @return Number of banks.
+     */
+    int32_t getRequiredBanks() const;
+
+    /**
+     * @brief Returns number of identifiers accepted but not requested by the terms.
+     *
+     * @return Number of identifiers.
+     */
+    uint32_t getTermsOverAccepted() const;
+
+    /**
+     * @brief Returns number of identifiers a term accepts which the next terms do not accept.
+     *
+     * @param term A term.
+     * @param from Index of the next term.
+     * @return Number of identifiers, saturated.
+     */
+    uint32_t getUncovered(const Term& term, size_t from) const;
+
+    /**
+     * @brief Returns number of requested identifiers a term accepts.
+     *
+     * @param term A term.
+     * @return Number of identifiers, saturated.
+     */
+    uint32_t getRequested(const Term& term) const;
+
+    /**
+     * @brief Puts terms to filter banks.
+     */
+    void pack();
+
+    /**
+     * @brief Assigns filter banks to FIFOs.
+     */
+    void balance();
+
+    /**
+     * @brief Adds a term to a filter bank.
+     *
+     * @param bank A filter bank.
+     * @param term A term.
+     */
+    void put(Bank& bank, const Term& term);
+
+    /**
+     * @brief Returns number of filter banks for terms.
+     *
+     * @param count Number of terms of each kind.
+     * @return Number of banks.
+     */
+    static int32_t getBanks(const size_t* count);
+
+    /**
+     * @brief Returns the space of a filter bank a term takes.
+     *
+     * @param term A term.
+     * @return Quarters of a bank.
+     */
+    static uint32_t getCost(const Term& term);
+
+    /**
+     * @brief Returns the kind of a term.
+     *
+     * @param term A term.
+     * @return The kind.
+     */
+    static Kind getKind(const Term& term);
+
+    /**
+     * @brief Returns number of identifiers a term accepts.
+     *
+     * @param term A term.
+     * @return Number of identifiers, saturated.
+     */
+    static uint32_t getAccepted(const Term& term);
+
+    /**
+     * @brief Returns number of identifiers a term accepts which are not greater than an identifier.
+     *
+     * @param term A term.
+     * @param last The identifier.
+     * @return Number of identifiers, saturated.
+     */
+    static uint32_t getAccepted(const Term& term, uint32_t last);
+
+    /**
+     * @brief Returns number of identifiers of free mask bits.
+     *
+     * @param free Bits not matched.
+     * @return Number of identifiers, saturated.
+     */
+    static uint32_t getAccepted(uint32_t free);
+
+    /**
+     * @brief Returns the identifier mask of all bits of a format.
+     *
+     * @param isExtended Extended format.
+     * @return The mask.
+     */
+    static uint32_t getFullMask(bool_t isExtended);
+
+    /**
+     * @brief Adds two numbers with saturation.
+     *
+     * @param a A number.
+     * @param b A number.
+     * @return The sum.
+     */
+    static uint32_t add(uint32_t a, uint32_t b);
+
+    /**
+     * @brief Terms memory.
+     */
+    Term* term_;
+
+    /**
+     * @brief Number of terms of the memory.
+     */
+    size_t size_;
+
+    /**
+     * @brief Number of terms.
+     */
+    size_t length_;
+
+    /**
+     * @brief Compiled rules.
+     */
+    const Rule* rules_;
+
+    /**
+     * @brief Number of compiled rules.
+     */
+    size_t number_;
+
+    /**
+     * @brief Number of requested identifiers.
+     */
+    uint32_t requested_;
+
+    /**
+     * @brief Filter banks.
+     */
+    Bank bank_[NUMBER_OF_BANKS];
+
+    /**
+     * @brief Number of filter banks.
+     */
+    int32_t banks_;
+
+    /**
+     * @brief Number of identifiers accepted but not requested.
+     */
+    uint32_t overAccepted_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANFILTER_HPP_
@@ -0,0 +1,87 @@
+/**
+ * @file      cpu.CanFrame.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANFRAME_HPP_
+#define CPU_CANFRAME_HPP_
+
+#include "cpu.Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @struct CanFrame
+ * @brief CAN frame.
+ */
+struct CanFrame
+{
+    /**
+     * @brief Maximal standard identifier.
+     */
+    static const uint32_t STANDARD_ID_MAX = 0x000007FF;
+
+    /**
+     * @brief Maximal extended identifier.
+     */
+    static const uint32_t EXTENDED_ID_MAX = 0x1FFFFFFF;
+
+    /**
+     * @brief Maximal number of data bytes.
+     */
+    static const uint8_t DATA_SIZE = 8;
+
+    /**
+     * @brief Constructor of an empty standard data frame.
+     */
+    CanFrame();
+
+    /**
+     * @brief Tests if the frame fields are correct.
+     *
+     * @return True if the frame is correct.
+     */
+    bool_t isFrame() const;
+
+    /**
+     * @brief Returns the arbitration field of the frame.
+     *
+     * The value is the base identifier, SRR or RTR, IDE, the identifier extension and RTR bits of the
+     * frame as they are transmitted, thus a frame of a lower value wins arbitration on the bus.
+     *
+     * @return The arbitration field.
+     */
+    uint32_t getArbitration() const;
+
+    /**
+     * @brief Identifier of 11 bits, or of 29 bits for an extended frame.
+     */
+    uint32_t id;
+
+    /**
+     * @brief Extended frame format.
+     */
+    bool_t isExtended;
+
+    /**
+     * @brief Remote frame.
+     */
+    bool_t isRemote;
+
+    /**
+     * @brief Data length code from 0 to 8.
+     */
+    uint8_t size;
+
+    /**
+     * @brief Data bytes.
+     */
+    uint8_t data[DATA_SIZE];
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANFRAME_HPP_
@@ -0,0 +1,198 @@
+/**
+ * @file      cpu.CanGateway.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANGATEWAY_HPP_
+#define CPU_CANGATEWAY_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "cpu.CanController.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanGateway
+ * @brief CAN frame forwarding from a CAN resource to a transport.
+ *
+ * The gateway is the RX listener of the source resource, thus frames matched by its routes are
+ * given to the destination transport in the RX interrupt handler. A forwarded frame is read from
+ * the RX FIFO straight to the transport, and it neither takes an RX ring slot nor wakes a thread
+ * up. Frames not matched are given to the next listener, or put to the RX ring.
+ *
+ * The transport is implemented by the application, like a serial link to another node, or
+ * a second CAN controller of an MCU which has one. A transport to the bus of the source resource
+ * is not allowed, as other nodes would receive forwarded frames twice.
+ *
+ * @note The destination transport is called in the RX interrupt handler of the source resource,
+ *       thus it queues a frame without blocking.
+ */
+class CanGateway : public NonCopyable<NoAllocator>, public CanController::Resource::Listener
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @class Transport
+     * @brief Destination of forwarded frames.
+     */
+    class Transport
+    {
+
+    public:
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Transport() {}
+
+        /**
+         * @brief Queues a frame to transmit.
+         *
+         * @param frame A frame, which is valid only until the function returns.
+         * @return True if the frame is queued.
+         */
+        virtual bool_t transmit(const CanFrame& frame) = 0;
+    };
+
+    /**
+     * @struct Route
+     * @brief Identifiers to forward.
+     */
+    struct Route
+    {
+        /**
+         * @brief Constructor of a route of all identifiers of a format.
+         */
+        Route();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param avalue      Identifier value.
+         * @param amask       Identifier mask of bits to be matched.
+         * @param aisExtended Extended identifiers.
+         */
+        Route(uint32_t avalue, uint32_t amask, bool_t aisExtended);
+
+        /**
+         * @brief Identifier value.
+         */
+        uint32_t value;
+
+        /**
+         * @brief Identifier mask of bits to be matched.
+         */
+        uint32_t mask;
+
+        /**
+         * @brief Extended identifiers.
+         */
+        bool_t isExtended;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param source      A resource to receive frames.
+     * @param destination A transport to forward frames.
+     * @param routes      Routes, which are referenced by the gateway.
+     * @param number      Number of routes.
+     * @param next        A listener of frames not forwarded, or a null pointer.
+     */
+    CanGateway(CanController::Resource& source, Transport& destination, const Route* routes, size_t number, CanController::Resource::Listener* next);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CanGateway();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @copydoc eoos::cpu::Can::Listener::accept(const RxFrame&)
+     */
+    virtual bool_t accept(const CanController::Resource::RxFrame& frame);
+
+    /**
+     * @brief Returns number of forwarded frames.
+     *
+     * @return Number of frames.
+     */
+    uint32_t getForwarded() const;
+
+    /**
+     * @brief Returns number of frames dropped as the destination has not queued them.
+     *
+     * @return Number of frames.
+     */
+    uint32_t getDropped() const;
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Tests if a frame is matched by a route.
+     *
+     * @param frame A frame.
+     * @return True if it is matched.
+     */
+    bool_t isRouted(const CanFrame& frame) const;
+
+    /**
+     * @brief Resource to receive frames.
+     */
+    CanController::Resource& source_;
+
+    /**
+     * @brief Transport to forward frames.
+     */
+    Transport& destination_;
+
+    /**
+     * @brief Routes.
+     */
+    const Route* routes_;
+
+    /**
+     * @brief Number of routes.
+     */
+    size_t number_;
+
+    /**
+     * @brief Listener of frames not forwarded.
+     */
+    CanController::Resource::Listener* next_;
+
+    /**
+     * @brief Number of forwarded frames.
+     */
+    uint32_t volatile forwarded_;
+
+    /**
+     * @brief Number of dropped frames.
+     */
+    uint32_t volatile dropped_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANGATEWAY_HPP_
@@ -0,0 +1,526 @@
+/**
+ * @file      cpu.CanTp.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CANTP_HPP_
+#define CPU_CANTP_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "api.Runnable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.CycleCounter.hpp"
+#include "cpu.CanController.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CanTp
+ * @brief ISO 15765-2 transport protocol over a CAN resource.
+ *
+ * Messages of up to 4 GB are segmented to a first frame and consecutive frames, which are sent in
+ * blocks as flow control frames of a receiver allow, and messages up to 7 bytes are sent in a single
+ * frame. Frames are taken by a listener of the CAN resource in its RX interrupt handler, thus a
+ * received message is reassembled in place into the buffer of the caller and only its end is
+ * signalled by a handler. Consecutive frames are sent in the RX interrupt handler on a flow control
+ * frame, and in a basic timer interrupt handler if the minimum separation time of the receiver is
+ * not zero, which is also a timer of N_Bs and N_Cr timeouts. Deadlines are kept in the CPU clock
+ * cycles and the one-pulse timer is started to the nearest of them.
+ *
+ * A message is sent or received once transmit() of the CAN resource queues its last frame.
+ *
+ * @note The resource uses one Interrupt resource of InterruptController and the RX listener of the
+ *       CAN resource, which must receive frames of the RX identifier.
+ * @note A deadline must be less than half the period of the CPU clock cycle counter.
+ */
+class CanTp : public NonCopyable<NoAllocator>, public CanController::Resource::Listener, public api::Runnable
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @enum Status
+     * @brief Status of a message.
+     */
+    enum Status
+    {
+        STATUS_IDLE = 0,    ///< No message
+        STATUS_BUSY,        ///< A message is being transferred
+        STATUS_DONE,        ///< A message has been transferred
+        STATUS_TIMEOUT,     ///< N_Bs or N_Cr timeout has been expired
+        STATUS_OVERFLOW,    ///< A message does not fit the buffer of a receiver
+        STATUS_ERROR        ///< A wrong sequence number or an unexpected frame
+    };
+
+    /**
+     * @struct Config
+     * @brief ISO-TP configuration.
+     */
+    struct Config
+    {
+        /**
+         * @brief Constructor of default configuration.
+         */
+        Config();
+
+        /**
+         * @brief Identifier of frames to send.
+         */
+        uint32_t txId;
+
+        /**
+         * @brief Identifier of frames to receive.
+         */
+        uint32_t rxId;
+
+        /**
+         * @brief Extended identifiers.
+         */
+        bool_t isExtended;
+
+        /**
+         * @brief Block size of consecutive frames to receive between flow control frames, or zero for all.
+         */
+        uint8_t blockSize;
+
+        /**
+         * @brief Minimum separation time of consecutive frames to receive as ISO 15765-2 encodes it.
+         */
+        uint8_t stMin;
+
+        /**
+         * @brief Value of unused data bytes, as all frames have eight data bytes.
+         */
+        uint8_t padding;
+
+        /**
+         * @brief Basic timer index as Registers::INDEX_TIMx is, which is not used by LIN or CAN.
+         */
+        int32_t timer;
+
+        /**
+         * @brief N_Bs and N_Cr timeout in microseconds.
+         */
+        uint32_t timeout;
+
+        /**
+         * @brief Handler called in an interrupt handler when a message is sent or fails, or a null pointer.
+         *
+         * A single frame message is sent by send(), which calls the handler.
+         */
+        api::Runnable* txHandler;
+
+        /**
+         * @brief Handler called in an interrupt handler when a message is received or fails, or a null pointer.
+         */
+        api::Runnable* rxHandler;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param can    A CAN resource.
+     * @param reg    Target CPU register model.
+     * @param gie    Global interrupt enable controller.
+     * @param ic     Interrupt controller.
+     * @param pll    PLL controller.
+     * @param cyc    CPU clock cycle counter.
+     * @param config Configuration.
+     */
+    CanTp(CanController::Resource& can, Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, PllController& pll, CycleCounter& cyc, const Config& config);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CanTp();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Starts sending a message.
+     *
+     * @param data A message, which is referenced until it is sent.
+     * @param size Number of bytes of the message.
+     * @return True if sending is started.
+     */
+    bool_t send(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Gives a buffer to receive one message.
+     *
+     * @param buffer A buffer, which is referenced until a message is received.
+     * @param size   Number of bytes of the buffer.
+     * @return True if the buffer is given.
+     */
+    bool_t receive(uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Returns the status of the sent message.
+     *
+     * @return The status.
+     */
+    Status getTxStatus() const;
+
+    /**
+     * @brief Returns the status of the received message.
+     *
+     * @return The status.
+     */
+    Status getRxStatus() const;
+
+    /**
+     * @brief Returns number of bytes of the received message.
+     *
+     * @return Number of bytes.
+     */
+    size_t getRxLength() const;
+
+    /**
+     * @copydoc eoos::cpu::Can::Listener::accept(const RxFrame&)
+     */
+    virtual bool_t accept(const CanController::Resource::RxFrame& frame);
+
+    /**
+     * @brief Handles the timer interrupt.
+     */
+    virtual void start();
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @enum Phase
+     * @brief Phases of a transfer.
+     */
+    enum Phase
+    {
+        PHASE_IDLE = 0,
+        PHASE_WAIT,     ///< TX waits a flow control frame, RX waits a consecutive frame
+        PHASE_SEND      ///< TX sends consecutive frames
+    };
+
+    /**
+     * @enum Pci
+     * @brief Protocol control information types.
+     */
+    enum Pci
+    {
+        PCI_SINGLE = 0,
+        PCI_FIRST = 1,
+        PCI_CONSECUTIVE = 2,
+        PCI_FLOW = 3
+    };
+
+    /**
+     * @enum FlowStatus
+     * @brief Flow status of a flow control frame.
+     */
+    enum FlowStatus
+    {
+        FLOW_CONTINUE = 0,
+        FLOW_WAIT = 1,
+        FLOW_OVERFLOW = 2
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the timer.
+     *
+     * @return True if initialized.
+     */
+    bool_t initializeTimer();
+
+    /**
+     * @brief Handles a single frame.
+     *
+     * @param frame A frame.
+     */
+    void handleSingle(const CanFrame& frame);
+
+    /**
+     * @brief Handles a first frame.
+     *
+     * @param frame A frame.
+     */
+    void handleFirst(const CanFrame& frame);
+
+    /**
+     * @brief Handles a consecutive frame.
+     *
+     * @param frame A frame.
+     */
+    void handleConsecutive(const CanFrame& frame);
+
+    /**
+     * @brief Handles a flow control frame.
+     *
+     * @param frame A frame.
+     */
+    void handleFlow(const CanFrame& frame);
+
+    /**
+     * @brief Sends consecutive frames until a block ends, the separation time is kept or the CAN queue is full.
+     */
+    void sendConsecutive();
+
+    /**
+     * @brief Sends a flow control frame.
+     *
+     * @param status A flow status.
+     * @return True if the frame is queued.
+     */
+    bool_t sendFlow(FlowStatus status);
+
+    /**
+     * @brief Queues a frame of data bytes with padding.
+     *
+     * @param data Data bytes.
+     * @param size Number of data bytes.
+     * @return True if the frame is queued.
+     */
+    bool_t transmit(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Ends sending a message.
+     *
+     * @param status The status of the message.
+     */
+    void finishTx(Status status);
+
+    /**
+     * @brief Ends receiving a message.
+     *
+     * @param status The status of the message.
+     */
+    void finishRx(Status status);
+
+    /**
+     * @brief Starts the timer to the nearest deadline, or stops it.
+     */
+    void schedule();
+
+    /**
+     * @brief Returns the deadline after a time.
+     *
+     * @param time Time in microseconds.
+     * @return The deadline in the CPU clock cycles.
+     */
+    uint32_t getDeadline(uint32_t time) const;
+
+    /**
+     * @brief Tests if a deadline is expired.
+     *
+     * @param deadline A deadline in the CPU clock cycles.
+     * @return True if it is expired.
+     */
+    bool_t isExpired(uint32_t deadline) const;
+
+    /**
+     * @brief Converts a minimum separation time as ISO 15765-2 encodes it to microseconds.
+     *
+     * @param stMin A minimum separation time.
+     * @return Time in microseconds.
+     */
+    static uint32_t getSeparationTime(uint8_t stMin);
+
+    /**
+     * @brief Enables or disables the timer clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableTimerClock(bool_t enable);
+
+    /**
+     * @brief Number of data bytes of a frame.
+     */
+    static const size_t FRAME_SIZE = CanFrame::DATA_SIZE;
+
+    /**
+     * @brief Maximal message size of a single frame.
+     */
+    static const size_t SINGLE_SIZE = FRAME_SIZE - 1U;
+
+    /**
+     * @brief Maximal message size of a first frame with a 12 bits length.
+     */
+    static const size_t SHORT_SIZE = 0x0FFF;
+
+    /**
+     * @brief Timer tick in microseconds.
+     */
+    static const uint32_t TIMER_TICK = 100;
+
+    /**
+     * @brief Maximal number of timer ticks.
+     */
+    static const uint32_t TIMER_TICKS_MAX = 0x00010000;
+
+    /**
+     * @brief CAN resource.
+     */
+    CanController::Resource& can_;
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Interrupt controller.
+     */
+    api::CpuInterruptController& ic_;
+
+    /**
+     * @brief CPU clock cycle counter.
+     */
+    CycleCounter& cyc_;
+
+    /**
+     * @brief Configuration.
+     */
+    Config config_;
+
+    /**
+     * @brief CPU clock cycles per microsecond.
+     */
+    uint32_t cyclesPerUs_;
+
+    /**
+     * @brief Timer clock in Hz.
+     */
+    int64_t timerClock_;
+
+    /**
+     * @brief Timer interrupt resource.
+     */
+    api::CpuInterrupt* timInt_;
+
+    /**
+     * @brief Timer registers.
+     */
+    reg::Tim* tim_;
+
+    /**
+     * @brief Message to send.
+     */
+    const uint8_t* txData_;
+
+    /**
+     * @brief Number of bytes of the message to send.
+     */
+    size_t txSize_;
+
+    /**
+     * @brief Number of bytes sent.
+     */
+    size_t txOffset_;
+
+    /**
+     * @brief Sequence number of the next consecutive frame to send.
+     */
+    uint8_t txSequence_;
+
+    /**
+     * @brief Block size of the receiver, or zero for all.
+     */
+    uint8_t txBlockSize_;
+
+    /**
+     * @brief Number of consecutive frames sent in the block.
+     */
+    uint8_t txBlock_;
+
+    /**
+     * @brief Minimum separation time of the receiver in microseconds.
+     */
+    uint32_t txStMin_;
+
+    /**
+     * @brief Phase of sending.
+     */
+    Phase volatile txPhase_;
+
+    /**
+     * @brief Deadline of sending in the CPU clock cycles.
+     */
+    uint32_t txDeadline_;
+
+    /**
+     * @brief Status of the sent message.
+     */
+    Status volatile txStatus_;
+
+    /**
+     * @brief Buffer to receive a message, or a null pointer.
+     */
+    uint8_t* rxBuffer_;
+
+    /**
+     * @brief Number of bytes of the buffer.
+     */
+    size_t rxSize_;
+
+    /**
+     * @brief Number of bytes of the message being received.
+     */
+    size_t rxLength_;
+
+    /**
+     * @brief Number of bytes received.
+     */
+    size_t rxOffset_;
+
+    /**
+     * @brief Sequence number of the next consecutive frame to receive.
+     */
+    uint8_t rxSequence_;
+
+    /**
+     * @brief Number of consecutive frames received in the block.
+     */
+    uint8_t rxBlock_;
+
+    /**
+     * @brief Phase of receiving.
+     */
+    Phase volatile rxPhase_;
+
+    /**
+     * @brief Deadline of receiving in the CPU clock cycles.
+     */
+    uint32_t rxDeadline_;
+
+    /**
+     * @brief Status of the received message.
+     */
+    Status volatile rxStatus_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CANTP_HPP_
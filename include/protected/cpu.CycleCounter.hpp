@@ -0,0 +1,96 @@
+/**
+ * @file      cpu.CycleCounter.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_CYCLECOUNTER_HPP_
+#define CPU_CYCLECOUNTER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class CycleCounter
+ * @brief CPU HW clock cycle counter of the data watchpoint and trace unit.
+ *
+ * The counter is a free-running 32 bits counter of the CPU clock, which wraps
+ * every 2^32 / HCLK seconds, that is about 59 seconds at 72 MHz.
+ */
+class CycleCounter : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     */
+    CycleCounter(Registers& reg, api::Guard& gie);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~CycleCounter();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Returns the CPU clock cycles.
+     *
+     * @return The cycle counter value.
+     */
+    uint32_t getCycles() const;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the counter.
+     *
+     * @return True if initialized.
+     */
+    bool_t initialize();
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Data watchpoint and trace unit.
+     */
+    reg::Dwt* dwt_;
+
+};
+
+inline uint32_t CycleCounter::getCycles() const
+{
+    return dwt_->cyccnt.value;
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_CYCLECOUNTER_HPP_
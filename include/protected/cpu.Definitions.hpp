@@ -45,6 +45,81 @@
     #define EOOS_GLOBAL_CPU_NUMBER_OF_SYSTEM_TIMERS (1)
 #endif
 
+#ifndef EOOS_GLOBAL_CPU_NUMBER_OF_USARTS
+    /**
+     * @brief Number of USART resources.
+     *
+     * @note Each USART resource also uses one Interrupt resource, thus 
+     *       EOOS_GLOBAL_CPU_NUMBER_OF_INTERRUPTS shall be increased respectively.
+     */
+    #define EOOS_GLOBAL_CPU_NUMBER_OF_USARTS (1)
+#endif
+
+#ifndef EOOS_GLOBAL_CPU_NUMBER_OF_LINS
+    /**
+     * @brief Number of LIN resources.
+     *
+     * @note Each LIN resource also uses one Interrupt resource, and a master one more, thus 
+     *       EOOS_GLOBAL_CPU_NUMBER_OF_INTERRUPTS shall be increased respectively.
+     */
+    #define EOOS_GLOBAL_CPU_NUMBER_OF_LINS (1)
+#endif
+
+#ifndef EOOS_GLOBAL_CPU_NUMBER_OF_CANS
+    /**
+     * @brief Number of CAN resources.
+     *
+     * @note Each CAN resource also uses two Interrupt resources, two more if it receives frames, and
+     *       one more for managed bus-off recovery, thus EOOS_GLOBAL_CPU_NUMBER_OF_INTERRUPTS shall be
+     *       increased respectively.
+     */
+    #define EOOS_GLOBAL_CPU_NUMBER_OF_CANS (1)
+#endif
+
+/**
+ * @brief Define context switching mode.
+ *
+ * @note
+ *  - If EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING is not defined, SysTick, PendSV and SVCall 
+ *    exceptions switch a task context on their return.
+ *  - If EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING is defined, SysTick exception only calls 
+ *    its handler and makes PendSV exception pending if the handler has switched a task,
+ *    and PendSV exception is set to the lowest priority level to switch a task context 
+ *    after all other pending exceptions.
+ *
+ * @note 
+ * 	The EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING shall be passed to the project build system
+ * 	through compile definition, and to the assembler through `--defsym` option.
+ */
+
+/**
+ * @brief Define thread stack guard.
+ *
+ * @note
+ *  - If EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD is defined, a thread context keeps a no-access MPU 
+ *    region, which is set by MpuController, on the lowest address of the thread stack, and
+ *    MemManage exception is handled by MpuController to report the stack overflow.
+ *  - The kernel port calls CpuMpuController_setStackGuard() for each created thread, like
+ *    from the FreeRTOS traceTASK_CREATE(pxNewTCB) macro as
+ *    CpuMpuController_setStackGuard(pxNewTCB->pxTopOfStack, pxNewTCB->pxStack).
+ *  - SysTick, SVCall and PendSV are set to a priority level lower than MemManage, thus
+ *    a scheduler exception which saves a context over the guard is reported as MemManage.
+ *
+ * @note 
+ * 	The EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD shall be passed to the project build system
+ * 	through compile definition, and to the assembler through `--defsym` option.
+ */
+
+#ifndef EOOS_GLOBAL_CPU_STACK_GUARD_SIZE
+    /**
+     * @brief Size of a thread stack guard in bytes, which is a power of two not less than 32.
+     *
+     * @note A function frame larger than the guard may be put over the guard without accessing it,
+     *       thus the size shall not be less than the largest frame of thread functions.
+     */
+    #define EOOS_GLOBAL_CPU_STACK_GUARD_SIZE (32)
+#endif
+
 /**
  * @brief Do compile error check of static allocated resources.
  */
@@ -60,4 +135,20 @@
     #error "The Cortex-M3 has only one system timer"
 #endif
 
+#if EOOS_GLOBAL_CPU_NUMBER_OF_USARTS > 5
+    #error "The MCU has only five USARTs"
+#endif
+
+#if EOOS_GLOBAL_CPU_NUMBER_OF_LINS > 5
+    #error "The MCU has only five USARTs for LIN"
+#endif
+
+#if EOOS_GLOBAL_CPU_NUMBER_OF_CANS > 1
+    #error "The MCU has only one CAN"
+#endif
+
+#if EOOS_GLOBAL_CPU_STACK_GUARD_SIZE < 32 || (EOOS_GLOBAL_CPU_STACK_GUARD_SIZE & (EOOS_GLOBAL_CPU_STACK_GUARD_SIZE - 1)) != 0
+    #error "The stack guard size must be a power of two not less than 32"
+#endif
+
 #endif // CPU_DEFINITIONS_HPP_
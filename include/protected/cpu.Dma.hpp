@@ -0,0 +1,161 @@
+/**
+ * @file      cpu.Dma.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_DMA_HPP_
+#define CPU_DMA_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Dma
+ * @brief CPU HW direct memory access channels.
+ *
+ * Interrupt flags of a channel are cleared by one store to the interrupt flag clear register,
+ * which changes only bits written with 1, thus channels are served without interrupts masking.
+ */
+class Dma : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @struct Channel
+     * @brief A channel of a DMA controller.
+     */
+    struct Channel
+    {
+        /**
+         * @brief Constructor of no channel.
+         */
+        Channel();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param adma    A DMA index as Registers::INDEX_DMAx is.
+         * @param anumber A channel number starting from 1.
+         */
+        Channel(int32_t adma, int32_t anumber);
+
+        /**
+         * @brief Tests if the channel exists.
+         *
+         * @return True if the channel exists.
+         */
+        bool_t isChannel() const;
+
+        /**
+         * @brief DMA index.
+         */
+        int32_t dma;
+
+        /**
+         * @brief Channel number.
+         */
+        int32_t number;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     */
+    Dma(Registers& reg, api::Guard& gie);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Dma();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Enables clock of a channel DMA controller.
+     *
+     * @param channel A channel.
+     * @return True if the clock is enabled.
+     */
+    bool_t enableClock(const Channel& channel);
+
+    /**
+     * @brief Returns registers of a channel.
+     *
+     * @param channel A channel.
+     * @return The channel registers, or a null pointer if the channel does not exist.
+     */
+    reg::Dma::Channel* getRegisters(const Channel& channel) const;
+
+    /**
+     * @brief Returns interrupt flags of a channel.
+     *
+     * @param channel A channel.
+     * @return The flags as reg::Dma::Isr::xxx_MASK values are.
+     */
+    uint32_t getFlags(const Channel& channel) const;
+
+    /**
+     * @brief Clears interrupt flags of a channel.
+     *
+     * @param channel A channel.
+     * @param flags   The flags as reg::Dma::Isr::xxx_MASK values are.
+     */
+    void clearFlags(const Channel& channel, uint32_t flags);
+
+    /**
+     * @brief Returns exception number of a channel.
+     *
+     * @param channel A channel.
+     * @return The exception number, or -1 if the channel does not exist.
+     */
+    static int32_t getException(const Channel& channel);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Returns a shift of channel flags in the ISR and IFCR registers.
+     *
+     * @param channel A channel.
+     * @return The shift.
+     */
+    static uint32_t getShift(const Channel& channel);
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_DMA_HPP_
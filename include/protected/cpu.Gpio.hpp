@@ -0,0 +1,169 @@
+/**
+ * @file      cpu.Gpio.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_GPIO_HPP_
+#define CPU_GPIO_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Gpio
+ * @brief CPU HW general-purpose input output pins.
+ *
+ * A pin mode is changed in a guarded section as it is a part of a port configuration register,
+ * but a pin output is changed by one store to the port bit set/reset register.
+ */
+class Gpio : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @enum Mode
+     * @brief Pin modes as CNF and MODE bits of port configuration registers.
+     */
+    enum Mode
+    {
+        MODE_INPUT_ANALOG         = 0x0, ///< Analog input
+        MODE_INPUT_FLOATING       = 0x4, ///< Floating input
+        MODE_INPUT_PULL           = 0x8, ///< Input with pull-up or pull-down set by the output
+        MODE_OUTPUT_PUSH_PULL     = 0x3, ///< General purpose push-pull output of 50 MHz
+        MODE_OUTPUT_OPEN_DRAIN    = 0x7, ///< General purpose open-drain output of 50 MHz
+        MODE_ALTERNATE_PUSH_PULL  = 0xB, ///< Alternate function push-pull output of 50 MHz
+        MODE_ALTERNATE_OPEN_DRAIN = 0xF  ///< Alternate function open-drain output of 50 MHz
+    };
+
+    /**
+     * @struct Pin
+     * @brief A pin of a port.
+     */
+    struct Pin
+    {
+        /**
+         * @brief Constructor of no pin.
+         */
+        Pin();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param aport   A port index as Registers::INDEX_GPIOx is.
+         * @param anumber A pin number of the port.
+         */
+        Pin(int32_t aport, int32_t anumber);
+
+        /**
+         * @brief Tests if the pin exists.
+         *
+         * @return True if the pin exists.
+         */
+        bool_t isPin() const;
+
+        /**
+         * @brief Port index.
+         */
+        int32_t port;
+
+        /**
+         * @brief Pin number.
+         */
+        int32_t number;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     */
+    Gpio(Registers& reg, api::Guard& gie);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Gpio();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Sets a pin mode and enables clock of the pin port.
+     *
+     * @param pin  A pin.
+     * @param mode A mode.
+     * @return True if the mode is set.
+     */
+    bool_t setMode(const Pin& pin, Mode mode);
+
+    /**
+     * @brief Sets a pin output to high level.
+     *
+     * @param pin A pin.
+     */
+    void set(const Pin& pin);
+
+    /**
+     * @brief Sets a pin output to low level.
+     *
+     * @param pin A pin.
+     */
+    void reset(const Pin& pin);
+
+    /**
+     * @brief Returns a pin input level.
+     *
+     * @param pin A pin.
+     * @return True if the level is high.
+     */
+    bool_t get(const Pin& pin) const;
+
+    /**
+     * @brief Number of ports.
+     */
+    static const int32_t NUMBER_OF_PORTS = 5;
+
+    /**
+     * @brief Number of pins of a port.
+     */
+    static const int32_t NUMBER_OF_PINS = 16;
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_GPIO_HPP_
@@ -11,6 +11,7 @@
 #include "api.Runnable.hpp"
 #include "api.Guard.hpp"
 #include "cpu.Registers.hpp"
+#include "cpu.Nvic.hpp"
 #include "lib.Guard.hpp"
 
 namespace eoos
@@ -122,10 +123,11 @@ public:
         /**
          * @brief Constructor.
          *
-         * @param reg Target CPU register model.     
-         * @param gie Global interrupt enable controller.     
+         * @param reg  Target CPU register model.     
+         * @param gie  Global interrupt enable controller.     
+         * @param nvic Nested vectored interrupt controller.     
          */
-        Data(Registers& areg, api::Guard& agie);
+        Data(Registers& areg, api::Guard& agie, Nvic& anvic);
         
         /**
          * @brief Target CPU register model.
@@ -136,6 +138,11 @@ public:
          * @brief Global interrupt enable controller.
          */
         api::Guard& gie;
+
+        /**
+         * @brief Nested vectored interrupt controller.
+         */
+        Nvic& nvic;
         
         /**
          * @brief Interrupt handlers.
@@ -335,39 +342,13 @@ bool_t Interrupt<A>::isException(int32_t exception)
 template <class A>
 void Interrupt<A>::disableIrq()
 {
-    int32_t const irq = exception_ - EXCEPTION_FIRST_IRQ;
-    uint32_t bitValue( 0x00000001 );
-    uint32_t const bitNumber( irq % 32 );    
-    for(uint32_t i(0U); i<bitNumber; i++)
-    {
-        bitValue <<= 1;
-    }
-    int32_t const index( irq / 32 );
-    {
-        lib::Guard<A> const guard(data_.gie);
-        uint32_t regValue( data_.reg.scs.nvic->icer[index].value );
-        regValue |= bitValue;
-        data_.reg.scs.nvic->icer[index].value = regValue;
-    }    
+    data_.nvic.disable(exception_ - EXCEPTION_FIRST_IRQ);
 }
 
 template <class A>
 void Interrupt<A>::enableIrq()
 {
-    int32_t const irq = exception_ - EXCEPTION_FIRST_IRQ;
-    uint32_t bitValue( 0x00000001 );
-    uint32_t const bitNumber( irq % 32 );    
-    for(uint32_t i(0U); i<bitNumber; i++)
-    {
-        bitValue <<= 1;
-    }
-    int32_t const index( irq / 32 );
-    {
-        lib::Guard<A> const guard(data_.gie);
-        uint32_t regValue( data_.reg.scs.nvic->iser[index].value );
-        regValue |= bitValue;
-        data_.reg.scs.nvic->iser[index].value = regValue;
-    }    
+    data_.nvic.enable(exception_ - EXCEPTION_FIRST_IRQ);
 }
 
 template <class A>
@@ -418,9 +399,10 @@ bool_t Interrupt<A>::setHandler(api::Runnable& handler, int32_t exception)
 }
 
 template <class A>
-Interrupt<A>::Data::Data(Registers& areg, api::Guard& agie)
+Interrupt<A>::Data::Data(Registers& areg, api::Guard& agie, Nvic& anvic)
     : reg(areg)
-    , gie(agie) {
+    , gie(agie)
+    , nvic(anvic) {
     for(int32_t i(0); i<EXCEPTION_LAST; i++)
     {
         handlers[i] = NULLPTR;
@@ -10,6 +10,7 @@
 #include "api.CpuInterruptController.hpp"
 #include "cpu.Interrupt.hpp"
 #include "cpu.Registers.hpp"
+#include "cpu.Nvic.hpp"
 #include "lib.ResourceMemory.hpp"
 
 namespace eoos
@@ -57,6 +58,13 @@ public:
      * the same priority level, and the level equal or less than any other interrupt 
      * priorities as this is very important for FreeRTOS port especially for the 
      * portYIELD_FROM_ISR() function usage.     
+     *
+     * @note If EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING is defined, PendSV is set to 
+     * the lowest priority level as it only switches a task context.
+     *
+     * @note If EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD is defined, SysTick, SVCall and PendSV
+     * are set to a level lower than the default one, thus MemManage of a context saved
+     * to a stack guard preempts them instead of escalating to HardFault.
      */
     virtual api::CpuInterrupt* createResource(api::Runnable& handler, int32_t source);
 
@@ -84,6 +92,13 @@ public:
      * @copydoc eoos::api::CpuInterruptController::getNumberPendSupervisor()
      */
     virtual int32_t getNumberPendSupervisor() const;    
+
+    /**
+     * @brief Returns the nested vectored interrupt controller.
+     *
+     * @return The NVIC.
+     */
+    Nvic& getNvic();
     
     /**
      * @brief Allocates memory.
@@ -128,6 +143,11 @@ private:
      * @brief Deinitializes the allocator.
      */
     static void deinitialize();
+
+    /**
+     * @brief Priority level of the scheduler exceptions with a stack guard, which is the highest of four priority bits under zero.
+     */
+    static const uint32_t SCHEDULER_PRIORITY = 0x10;
     
     /**
      * @brief Heap for resource allocation.
@@ -149,6 +169,11 @@ private:
      */
     api::Guard& gie_;    
 
+    /**
+     * @brief Nested vectored interrupt controller.
+     */
+    Nvic nvic_;
+
     /**
      * @brief Resource memory allocator.
      */     
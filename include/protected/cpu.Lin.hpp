@@ -0,0 +1,1169 @@
+/**
+ * @file      cpu.Lin.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_LIN_HPP_
+#define CPU_LIN_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "api.Runnable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+#include "cpu.Interrupt.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.UsartBaud.hpp"
+#include "cpu.LinProtocol.hpp"
+#include "cpu.BitBand.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Lin
+ * @brief CPU HW LIN resource on an USART in LIN mode.
+ *
+ * The resource runs a frame state machine in the USART interrupt handler. A break is detected by
+ * the USART LIN break detection, then the sync field and the protected identifier are checked, and
+ * a frame of the identifier is either responded with its data and checksum, or received and checked
+ * by its checksum. A master node also generates headers by its schedule table in the interrupt handler
+ * of a basic timer, which is reloaded with the time of each slot. As the bus is half-duplex, the master
+ * receives its own headers and passes them through the same state machine, and a node compares each
+ * echoed byte of its response with the transmitted one.
+ *
+ * @note The resource uses the USART and its interrupt, thus the USART cannot be used by an Usart
+ *       resource, and a master also uses a basic timer and its interrupt.
+ *
+ * @tparam A Heap memory allocator class.
+ */
+template <class A>
+class Lin : public NonCopyable<A>, public api::Runnable
+{
+    typedef NonCopyable<A> Parent;
+
+public:
+
+    /**
+     * @enum Role
+     * @brief Node role.
+     */
+    enum Role
+    {
+        ROLE_SLAVE = 0, ///< Responds to headers
+        ROLE_MASTER     ///< Sends headers by the schedule table and responds to them
+    };
+
+    /**
+     * @enum Direction
+     * @brief Frame response direction of the node.
+     */
+    enum Direction
+    {
+        DIRECTION_SUBSCRIBE = 0, ///< The node receives the response
+        DIRECTION_PUBLISH        ///< The node transmits the response
+    };
+
+    /**
+     * @enum Status
+     * @brief Last frame status.
+     */
+    enum Status
+    {
+        STATUS_NONE = 0,       ///< The frame has not been transferred yet
+        STATUS_OK,             ///< The response is transferred
+        STATUS_ERROR_BIT,      ///< An echoed byte differs from the transmitted one
+        STATUS_ERROR_FRAMING,  ///< A byte has no stop bit
+        STATUS_ERROR_CHECKSUM, ///< The received checksum is wrong
+        STATUS_ERROR_TIMEOUT   ///< The response is not completed until a next header
+    };
+
+    /**
+     * @struct Frame
+     * @brief Frame of the node.
+     *
+     * @note Data of a published frame are read in the USART interrupt context on its header, thus
+     *       they are changed by a caller within a critical section. Data of a subscribed frame are
+     *       written in the USART interrupt context before its status is set to STATUS_OK.
+     */
+    struct Frame
+    {
+        /**
+         * @brief Constructor of an empty frame.
+         */
+        Frame();
+
+        /**
+         * @brief Frame identifier from 0 to 63.
+         */
+        uint8_t id;
+
+        /**
+         * @brief Response direction.
+         */
+        Direction direction;
+
+        /**
+         * @brief Enhanced checksum, which LIN 2.x uses, or classic checksum of LIN 1.x.
+         */
+        bool_t enhanced;
+
+        /**
+         * @brief Number of data bytes from 1 to 8.
+         */
+        uint8_t size;
+
+        /**
+         * @brief Data bytes.
+         */
+        uint8_t data[LinProtocol::DATA_SIZE];
+
+        /**
+         * @brief Last status.
+         */
+        Status volatile status;
+
+        /**
+         * @brief Handler of the frame completion, or a null pointer.
+         *
+         * @note The handler is called in the USART or the timer interrupt context.
+         */
+        api::Runnable* handler;
+    };
+
+    /**
+     * @struct Slot
+     * @brief Slot of a master schedule table.
+     */
+    struct Slot
+    {
+        /**
+         * @brief Constructor of an empty slot.
+         */
+        Slot();
+
+        /**
+         * @brief Frame identifier of the header to send.
+         */
+        uint8_t id;
+
+        /**
+         * @brief Slot time in microseconds, which is a multiple of TIMER_TICK.
+         */
+        uint32_t time;
+    };
+
+    /**
+     * @struct Config
+     * @brief LIN configuration.
+     */
+    struct Config
+    {
+        /**
+         * @brief Constructor of default configuration.
+         */
+        Config();
+
+        /**
+         * @brief Baud rate.
+         */
+        int32_t baud;
+
+        /**
+         * @brief Node role.
+         */
+        Role role;
+
+        /**
+         * @brief Frames of the node.
+         */
+        Frame* frames;
+
+        /**
+         * @brief Number of frames.
+         */
+        size_t numberOfFrames;
+
+        /**
+         * @brief Master schedule table, which is executed cyclically.
+         */
+        const Slot* schedule;
+
+        /**
+         * @brief Number of schedule table slots.
+         */
+        size_t numberOfSlots;
+
+        /**
+         * @brief Master basic timer index as Registers::INDEX_TIMx is.
+         */
+        int32_t timer;
+    };
+
+    /**
+     * @struct Data
+     * @brief Global data for all these objects;
+     */
+    struct Data
+    {
+        /**
+         * @brief Constructor.
+         *
+         * @param reg  Target CPU register model.
+         * @param gie  Global interrupt enable controller.
+         * @param ic   Interrupt controller.
+         * @param gpio General-purpose input output pins.
+         * @param pll  PLL controller.
+         */
+        Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, PllController& apll);
+
+        /**
+         * @brief Target CPU register model.
+         */
+        Registers& reg;
+
+        /**
+         * @brief Global interrupt enable controller.
+         */
+        api::Guard& gie;
+
+        /**
+         * @brief Interrupt controller.
+         */
+        api::CpuInterruptController& ic;
+
+        /**
+         * @brief General-purpose input output pins.
+         */
+        Gpio& gpio;
+
+        /**
+         * @brief PLL controller.
+         */
+        PllController& pll;
+    };
+
+    /**
+     * @brief Schedule timer tick in microseconds.
+     */
+    static const uint32_t TIMER_TICK = 100;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param data   Global data for all theses objects.
+     * @param index  USART index as Registers::INDEX_USARTx is.
+     * @param config Configuration.
+     */
+    Lin(Data& data, int32_t index, const Config& config);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Lin();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Handles the USART interrupt.
+     */
+    virtual void start();
+
+    /**
+     * @brief Sends a header out of the schedule table.
+     *
+     * @param id A frame identifier.
+     * @return True if the header is being sent.
+     */
+    bool_t sendHeader(uint8_t id);
+
+    /**
+     * @brief Returns the USART index.
+     *
+     * @return The index.
+     */
+    int32_t getIndex() const;
+
+    /**
+     * @brief Tests if an USART index is valid.
+     *
+     * @param index An USART index.
+     * @return True if it is valid.
+     */
+    static bool_t isIndex(int32_t index);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @enum State
+     * @brief Frame state.
+     */
+    enum State
+    {
+        STATE_IDLE = 0, ///< Waiting for a break
+        STATE_SYNC,     ///< Waiting for the sync field
+        STATE_PID,      ///< Waiting for the protected identifier
+        STATE_RESPONSE  ///< Transferring the response
+    };
+
+    /**
+     * @class Handler
+     * @brief Interrupt handler which calls a function of the resource.
+     */
+    class Handler : public api::Runnable
+    {
+
+    public:
+
+        /**
+         * @brief A function of the resource.
+         */
+        typedef void (Lin::*Function)();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param lin      The resource.
+         * @param function A function to call.
+         */
+        Handler(Lin& lin, Function function);
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Handler();
+
+        /**
+         * @copydoc eoos::api::Object::isConstructed()
+         */
+        virtual bool_t isConstructed() const;
+
+        /**
+         * @copydoc eoos::api::Runnable::start()
+         */
+        virtual void start();
+
+    private:
+
+        /**
+         * @brief The resource.
+         */
+        Lin& lin_;
+
+        /**
+         * @brief A function to call.
+         */
+        Function function_;
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Tests if the configuration is correct.
+     *
+     * @return True if it is correct.
+     */
+    bool_t isConfig() const;
+
+    /**
+     * @brief Initializes the hardware.
+     *
+     * @return True if initialized.
+     */
+    bool_t initialize();
+
+    /**
+     * @brief Deinitializes the hardware.
+     */
+    void deinitialize();
+
+    /**
+     * @brief Initializes the master schedule timer.
+     *
+     * @return True if initialized.
+     */
+    bool_t initializeTimer();
+
+    /**
+     * @brief Creates an interrupt resource.
+     *
+     * @param handler   An interrupt handler.
+     * @param exception An exception number.
+     * @return The interrupt resource, or a null pointer if an error has been occurred.
+     */
+    api::CpuInterrupt* createInterrupt(api::Runnable& handler, int32_t exception);
+
+    /**
+     * @brief Handles the timer interrupt.
+     */
+    void handleTimer();
+
+    /**
+     * @brief Handles a received byte.
+     *
+     * @param byte  The byte.
+     * @param error True if the byte has a framing error.
+     */
+    void receive(uint8_t byte, bool_t error);
+
+    /**
+     * @brief Starts a response of the current frame.
+     */
+    void startResponse();
+
+    /**
+     * @brief Completes the current frame.
+     *
+     * @param status A status of the frame.
+     */
+    void complete(Status status);
+
+    /**
+     * @brief Returns a frame of the node.
+     *
+     * @param pid A protected identifier.
+     * @return The frame, or a null pointer if the identifier is wrong or the node has no the frame.
+     */
+    Frame* getFrame(uint8_t pid) const;
+
+    /**
+     * @brief Enables or disables the USART clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableClock(bool_t enable);
+
+    /**
+     * @brief Enables or disables the timer clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableTimerClock(bool_t enable);
+
+    /**
+     * @brief Sets the USART pins to their alternate functions.
+     *
+     * @return True if the pins are set.
+     */
+    bool_t initializePins();
+
+    /**
+     * @brief Returns the USART exception number.
+     *
+     * @return The exception number.
+     */
+    int32_t getException() const;
+
+    /**
+     * @brief Returns the USART TX pin.
+     *
+     * @return The pin.
+     */
+    Gpio::Pin getPinTx() const;
+
+    /**
+     * @brief Returns the USART RX pin.
+     *
+     * @return The pin.
+     */
+    Gpio::Pin getPinRx() const;
+
+    /**
+     * @brief Number of USARTs.
+     */
+    static const int32_t NUMBER_OF_USARTS = 5;
+
+    /**
+     * @brief Number of basic timers.
+     */
+    static const int32_t NUMBER_OF_TIMERS = 2;
+
+    /**
+     * @brief Global data for all these objects;
+     */
+    Data& data_;
+
+    /**
+     * @brief USART index.
+     */
+    int32_t index_;
+
+    /**
+     * @brief Configuration.
+     */
+    Config config_;
+
+    /**
+     * @brief USART registers.
+     */
+    reg::Usart* usart_;
+
+    /**
+     * @brief Master schedule timer registers.
+     */
+    reg::Tim* tim_;
+
+    /**
+     * @brief USART interrupt resource.
+     */
+    api::CpuInterrupt* int_;
+
+    /**
+     * @brief Timer interrupt handler.
+     */
+    Handler timHandler_;
+
+    /**
+     * @brief Timer interrupt resource.
+     */
+    api::CpuInterrupt* timInt_;
+
+    /**
+     * @brief Frame state.
+     */
+    State state_;
+
+    /**
+     * @brief Protected identifier of a header which this node is sending.
+     */
+    uint8_t header_;
+
+    /**
+     * @brief This node is sending a header.
+     */
+    bool_t isHeader_;
+
+    /**
+     * @brief Current frame.
+     */
+    Frame* frame_;
+
+    /**
+     * @brief Protected identifier of the current frame.
+     */
+    uint8_t pid_;
+
+    /**
+     * @brief Number of transferred response bytes.
+     */
+    uint32_t count_;
+
+    /**
+     * @brief Response data and checksum.
+     */
+    uint8_t response_[LinProtocol::DATA_SIZE + 1];
+
+    /**
+     * @brief Current slot of the schedule table.
+     */
+    size_t slot_;
+
+};
+
+template <class A>
+Lin<A>::Lin(Data& data, int32_t index, const Config& config)
+    : NonCopyable<A>()
+    , api::Runnable()
+    , data_( data )
+    , index_( index )
+    , config_( config )
+    , usart_( isIndex(index) ? data.reg.usart[index] : NULLPTR )
+    , tim_( NULLPTR )
+    , int_( NULLPTR )
+    , timHandler_( *this, &Lin::handleTimer )
+    , timInt_( NULLPTR )
+    , state_( STATE_IDLE )
+    , header_( 0 )
+    , isHeader_( false )
+    , frame_( NULLPTR )
+    , pid_( 0 )
+    , count_( 0 )
+    , response_()
+    , slot_( 0 ) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+template <class A>
+Lin<A>::~Lin()
+{
+    deinitialize();
+}
+
+template <class A>
+bool_t Lin<A>::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+template <class A>
+void Lin<A>::start()
+{
+    reg::Usart::Sr const sr( usart_->sr.value );
+    if( sr.bit.lbd == 1 )
+    {
+        usart_->sr.value = ~reg::Usart::Sr::LBD_MASK;
+        // A break aborts an uncompleted response
+        complete(STATUS_ERROR_TIMEOUT);
+        state_ = STATE_SYNC;
+    }
+    if( sr.bit.rxne == 1 || sr.bit.ore == 1 )
+    {
+        // Reading DR after SR clears RXNE and the ORE, NE, FE and PE error flags
+        uint8_t const byte( static_cast<uint8_t>(usart_->dr.value) );
+        receive(byte, sr.bit.fe == 1);
+    }
+}
+
+template <class A>
+bool_t Lin<A>::sendHeader(uint8_t id)
+{
+    if( !isConstructed() || config_.role != ROLE_MASTER || id >= LinProtocol::NUMBER_OF_IDS )
+    {
+        return false;
+    }
+    lib::Guard<A> const guard(data_.gie);
+    // A new header aborts an uncompleted response
+    complete(STATUS_ERROR_TIMEOUT);
+    header_ = LinProtocol::getPid(id);
+    isHeader_ = true;
+    // The break is sent after the current byte, and the sync field after the break, then the
+    // protected identifier is written on the sync field echo as DR can hold only one byte
+    BitBand::set(usart_->cr1, reg::Usart::Cr1::SBK_BIT);
+    usart_->dr.value = LinProtocol::SYNC;
+    return true;
+}
+
+template <class A>
+int32_t Lin<A>::getIndex() const
+{
+    return index_;
+}
+
+template <class A>
+bool_t Lin<A>::isIndex(int32_t index)
+{
+    return 0 <= index && index < NUMBER_OF_USARTS;
+}
+
+template <class A>
+bool_t Lin<A>::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( usart_ == NULLPTR )
+        {
+            break;
+        }
+        if( !isConfig() )
+        {
+            break;
+        }
+        if( !initialize() )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+template <class A>
+bool_t Lin<A>::isConfig() const
+{
+    if( config_.frames == NULLPTR && config_.numberOfFrames != 0U )
+    {
+        return false;
+    }
+    for(size_t i(0U); i<config_.numberOfFrames; i++)
+    {
+        Frame const& frame( config_.frames[i] );
+        if( frame.id >= LinProtocol::NUMBER_OF_IDS || frame.size == 0U || frame.size > LinProtocol::DATA_SIZE )
+        {
+            return false;
+        }
+    }
+    if( config_.role == ROLE_SLAVE )
+    {
+        return true;
+    }
+    if( config_.schedule == NULLPTR || config_.numberOfSlots == 0U )
+    {
+        return false;
+    }
+    if( config_.timer < 0 || config_.timer >= NUMBER_OF_TIMERS )
+    {
+        return false;
+    }
+    for(size_t i(0U); i<config_.numberOfSlots; i++)
+    {
+        Slot const& slot( config_.schedule[i] );
+        // The timer auto-reload register is 16 bits
+        if( slot.id >= LinProtocol::NUMBER_OF_IDS || slot.time < TIMER_TICK || slot.time / TIMER_TICK > 0x00010000U )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class A>
+bool_t Lin<A>::initialize()
+{
+    // Occupy the USART by its interrupt handler, as the handler can be set only once
+    int_ = createInterrupt(*this, getException());
+    if( int_ == NULLPTR )
+    {
+        return false;
+    }
+    // USART1 is clocked by APB2, and others are clocked by APB1
+    int64_t const clock( ( index_ == Registers::INDEX_USART1 ) ? data_.pll.getApb2Clock() : data_.pll.getApb1Clock() );
+    UsartBaud::Result baud;
+    if( !UsartBaud::calculate(clock, config_.baud, baud) )
+    {
+        return false;
+    }
+    if( !initializePins() )
+    {
+        return false;
+    }
+    if( config_.role == ROLE_MASTER && !initializeTimer() )
+    {
+        return false;
+    }
+    {
+        lib::Guard<A> const guard(data_.gie);
+        enableClock(true);
+        usart_->cr1.value = 0;
+        usart_->brr.value = baud.brr;
+        reg::Usart::Cr2 cr2(0);
+        cr2.bit.linen = 1;
+        cr2.bit.lbdl = 1;   // 11 bits break detection
+        cr2.bit.lbdie = 1;
+        usart_->cr2.value = cr2.value;
+        usart_->cr3.value = 0;
+        reg::Usart::Cr1 cr1(0);
+        cr1.bit.re = 1;
+        cr1.bit.te = 1;
+        cr1.bit.rxneie = 1;
+        cr1.bit.ue = 1;
+        usart_->cr1.value = cr1.value;
+    }
+    int_->enable();
+    if( timInt_ != NULLPTR )
+    {
+        timInt_->enable();
+        // Start the schedule table from its first slot on the first update event
+        tim_->cr1.bit.cen = 1;
+    }
+    return true;
+}
+
+template <class A>
+void Lin<A>::deinitialize()
+{
+    if( timInt_ != NULLPTR )
+    {
+        timInt_->disable();
+        if( tim_ != NULLPTR )
+        {
+            lib::Guard<A> const guard(data_.gie);
+            tim_->cr1.value = 0;
+            tim_->dier.value = 0;
+            enableTimerClock(false);
+        }
+        delete timInt_;
+        timInt_ = NULLPTR;
+    }
+    if( int_ != NULLPTR )
+    {
+        int_->disable();
+        {
+            lib::Guard<A> const guard(data_.gie);
+            usart_->cr1.value = 0;
+            usart_->cr2.value = 0;
+            enableClock(false);
+        }
+        delete int_;
+        int_ = NULLPTR;
+    }
+}
+
+template <class A>
+bool_t Lin<A>::initializeTimer()
+{
+    int32_t const exception( ( config_.timer == Registers::INDEX_TIM6 ) ? Interrupt<A>::EXCEPTION_TIM6 : Interrupt<A>::EXCEPTION_TIM7 );
+    timInt_ = createInterrupt(timHandler_, exception);
+    if( timInt_ == NULLPTR )
+    {
+        return false;
+    }
+    // Timers of APB1 are clocked twice faster than APB1 if APB1 prescaler is not 1
+    int64_t clock( data_.pll.getApb1Clock() );
+    if( clock != data_.pll.getAhbClock() )
+    {
+        clock *= 2;
+    }
+    int64_t const psc( clock / (1000000 / TIMER_TICK) - 1 );
+    if( psc < 0 || psc > 0x0000FFFF )
+    {
+        return false;
+    }
+    tim_ = data_.reg.tim[config_.timer];
+    lib::Guard<A> const guard(data_.gie);
+    enableTimerClock(true);
+    tim_->cr1.value = 0;
+    tim_->psc.value = static_cast<reg::Tim::Cnt::Value>(psc);
+    tim_->arr.value = 0;
+    // Load the prescaler, and leave UIF set to send the first header once the interrupt is enabled
+    tim_->egr.bit.ug = 1;
+    tim_->dier.bit.uie = 1;
+    return true;
+}
+
+template <class A>
+api::CpuInterrupt* Lin<A>::createInterrupt(api::Runnable& handler, int32_t exception)
+{
+    api::CpuInterrupt* res( data_.ic.createResource(handler, exception) );
+    if( res != NULLPTR )
+    {
+        if( !res->isConstructed() )
+        {
+            delete res;
+            res = NULLPTR;
+        }
+    }
+    return res;
+}
+
+template <class A>
+void Lin<A>::handleTimer()
+{
+    tim_->sr.value = 0;
+    Slot const& slot( config_.schedule[slot_] );
+    // The counter has been reset by the update event, thus the new reload value applies to this slot
+    tim_->arr.value = slot.time / TIMER_TICK - 1U;
+    slot_ = ( slot_ + 1U < config_.numberOfSlots ) ? slot_ + 1U : 0U;
+    static_cast<void>( sendHeader(slot.id) );
+}
+
+template <class A>
+void Lin<A>::receive(uint8_t byte, bool_t error)
+{
+    switch(state_)
+    {
+        case STATE_SYNC:
+        {
+            // The break is received as a zero byte with a framing error
+            if( error || byte == 0U )
+            {
+                break;
+            }
+            if( byte != LinProtocol::SYNC )
+            {
+                state_ = STATE_IDLE;
+                isHeader_ = false;
+                break;
+            }
+            state_ = STATE_PID;
+            if( isHeader_ )
+            {
+                isHeader_ = false;
+                usart_->dr.value = header_;
+            }
+            break;
+        }
+        case STATE_PID:
+        {
+            frame_ = error ? NULLPTR : getFrame(byte);
+            if( frame_ == NULLPTR )
+            {
+                state_ = STATE_IDLE;
+                break;
+            }
+            pid_ = byte;
+            count_ = 0U;
+            state_ = STATE_RESPONSE;
+            if( frame_->direction == DIRECTION_PUBLISH )
+            {
+                startResponse();
+            }
+            break;
+        }
+        case STATE_RESPONSE:
+        {
+            if( error )
+            {
+                complete(STATUS_ERROR_FRAMING);
+                break;
+            }
+            uint32_t const size( frame_->size );
+            if( frame_->direction == DIRECTION_PUBLISH )
+            {
+                // The bus is wired-AND, thus a differed echo means another node has transmitted
+                if( byte != response_[count_] )
+                {
+                    complete(STATUS_ERROR_BIT);
+                    break;
+                }
+                count_++;
+                if( count_ <= size )
+                {
+                    usart_->dr.value = response_[count_];
+                }
+                else
+                {
+                    complete(STATUS_OK);
+                }
+                break;
+            }
+            response_[count_] = byte;
+            count_++;
+            if( count_ <= size )
+            {
+                break;
+            }
+            if( LinProtocol::getChecksum(pid_, response_, size, frame_->enhanced) != response_[size] )
+            {
+                complete(STATUS_ERROR_CHECKSUM);
+                break;
+            }
+            for(uint32_t i(0U); i<size; i++)
+            {
+                frame_->data[i] = response_[i];
+            }
+            complete(STATUS_OK);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+template <class A>
+void Lin<A>::startResponse()
+{
+    uint32_t const size( frame_->size );
+    for(uint32_t i(0U); i<size; i++)
+    {
+        response_[i] = frame_->data[i];
+    }
+    response_[size] = LinProtocol::getChecksum(pid_, response_, size, frame_->enhanced);
+    usart_->dr.value = response_[0];
+}
+
+template <class A>
+void Lin<A>::complete(Status status)
+{
+    state_ = STATE_IDLE;
+    Frame* const frame( frame_ );
+    if( frame == NULLPTR )
+    {
+        return;
+    }
+    frame_ = NULLPTR;
+    frame->status = status;
+    if( frame->handler != NULLPTR )
+    {
+        frame->handler->start();
+    }
+}
+
+template <class A>
+typename Lin<A>::Frame* Lin<A>::getFrame(uint8_t pid) const
+{
+    if( !LinProtocol::isPid(pid) )
+    {
+        return NULLPTR;
+    }
+    uint8_t const id( pid & 0x3FU );
+    for(size_t i(0U); i<config_.numberOfFrames; i++)
+    {
+        if( config_.frames[i].id == id )
+        {
+            return &config_.frames[i];
+        }
+    }
+    return NULLPTR;
+}
+
+template <class A>
+void Lin<A>::enableClock(bool_t enable)
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1:
+        {
+            data_.reg.rcc->apb2enr.bit.usart1en = enable ? 1 : 0;
+            break;
+        }
+        default:
+        {
+            // USART2EN is bit 17 of APB1ENR and USART3EN, UART4EN and UART5EN follow it
+            reg::Rcc::Apb1enr::Value const apb1enr( 0x00020000U << (index_ - Registers::INDEX_USART2) );
+            if( enable )
+            {
+                data_.reg.rcc->apb1enr.value |= apb1enr;
+            }
+            else
+            {
+                data_.reg.rcc->apb1enr.value &= ~apb1enr;
+            }
+            break;
+        }
+    }
+}
+
+template <class A>
+void Lin<A>::enableTimerClock(bool_t enable)
+{
+    if( config_.timer == Registers::INDEX_TIM6 )
+    {
+        data_.reg.rcc->apb1enr.bit.tim6en = enable ? 1 : 0;
+    }
+    else
+    {
+        data_.reg.rcc->apb1enr.bit.tim7en = enable ? 1 : 0;
+    }
+}
+
+template <class A>
+bool_t Lin<A>::initializePins()
+{
+    if( !data_.gpio.setMode(getPinTx(), Gpio::MODE_ALTERNATE_PUSH_PULL) )
+    {
+        return false;
+    }
+    if( !data_.gpio.setMode(getPinRx(), Gpio::MODE_INPUT_FLOATING) )
+    {
+        return false;
+    }
+    return true;
+}
+
+template <class A>
+int32_t Lin<A>::getException() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Interrupt<A>::EXCEPTION_USART1;
+        case Registers::INDEX_USART2: return Interrupt<A>::EXCEPTION_USART2;
+        case Registers::INDEX_USART3: return Interrupt<A>::EXCEPTION_USART3;
+        case Registers::INDEX_UART4:  return Interrupt<A>::EXCEPTION_UART4;
+        default:                      return Interrupt<A>::EXCEPTION_UART5;
+    }
+}
+
+template <class A>
+Gpio::Pin Lin<A>::getPinTx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 9);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 2);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 10);
+        case Registers::INDEX_UART4:  return Gpio::Pin(Registers::INDEX_GPIOC, 10);
+        default:                      return Gpio::Pin(Registers::INDEX_GPIOC, 12);
+    }
+}
+
+template <class A>
+Gpio::Pin Lin<A>::getPinRx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 10);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 3);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 11);
+        case Registers::INDEX_UART4:  return Gpio::Pin(Registers::INDEX_GPIOC, 11);
+        default:                      return Gpio::Pin(Registers::INDEX_GPIOD, 2);
+    }
+}
+
+template <class A>
+Lin<A>::Frame::Frame()
+    : id(0)
+    , direction(DIRECTION_SUBSCRIBE)
+    , enhanced(true)
+    , size(0)
+    , data()
+    , status(STATUS_NONE)
+    , handler(NULLPTR) {
+}
+
+template <class A>
+Lin<A>::Slot::Slot()
+    : id(0)
+    , time(0) {
+}
+
+template <class A>
+Lin<A>::Config::Config()
+    : baud(19200)
+    , role(ROLE_SLAVE)
+    , frames(NULLPTR)
+    , numberOfFrames(0)
+    , schedule(NULLPTR)
+    , numberOfSlots(0)
+    , timer(Registers::INDEX_TIM6) {
+}
+
+template <class A>
+Lin<A>::Data::Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, PllController& apll)
+    : reg(areg)
+    , gie(agie)
+    , ic(aic)
+    , gpio(agpio)
+    , pll(apll) {
+}
+
+template <class A>
+Lin<A>::Handler::Handler(Lin& lin, Function function)
+    : api::Runnable()
+    , lin_( lin )
+    , function_( function ) {
+}
+
+template <class A>
+Lin<A>::Handler::~Handler()
+{
+}
+
+template <class A>
+bool_t Lin<A>::Handler::isConstructed() const
+{
+    return true;
+}
+
+template <class A>
+void Lin<A>::Handler::start()
+{
+    (lin_.*function_)();
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_LIN_HPP_
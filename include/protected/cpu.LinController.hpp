@@ -0,0 +1,133 @@
+/**
+ * @file      cpu.LinController.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_LINCONTROLLER_HPP_
+#define CPU_LINCONTROLLER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "cpu.Lin.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.Registers.hpp"
+#include "lib.ResourceMemory.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class LinController
+ * @brief CPU HW LIN controller.
+ */
+class LinController : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief LIN resource.
+     */
+    typedef Lin<LinController> Resource;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg  Target CPU register model.
+     * @param gie  Global interrupt enable controller.
+     * @param ic   Interrupt controller.
+     * @param gpio General-purpose input output pins.
+     * @param pll  PLL controller.
+     */
+    LinController(Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, Gpio& gpio, PllController& pll);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~LinController();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Creates a new LIN resource.
+     *
+     * @param index  USART index as Registers::INDEX_USARTx is.
+     * @param config Configuration.
+     * @return A new LIN resource, or NULLPTR if an error has been occurred.
+     */
+    Resource* createResource(int32_t index, const Resource::Config& config);
+
+    /**
+     * @brief Allocates memory.
+     *
+     * @param size Number of bytes to allocate.
+     * @return Allocated memory address or a null pointer.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * @brief Frees allocated memory.
+     *
+     * @param ptr Address of allocated memory block or a null pointer.
+     */
+    static void free(void* ptr);
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the allocator with heap for resource allocation.
+     *
+     * @param resource Heap for resource allocation.
+     * @return True if initialized.
+     */
+    static bool_t initialize(api::Heap* resource);
+
+    /**
+     * @brief Deinitializes the allocator.
+     */
+    static void deinitialize();
+
+    /**
+     * @brief Heap for resource allocation.
+     */
+    static api::Heap* resource_;
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Resource memory allocator.
+     */
+    lib::ResourceMemory<Resource, EOOS_GLOBAL_CPU_NUMBER_OF_LINS> memory_;
+
+    /**
+     * @brief Global data for all Lin objects;
+     */
+    Resource::Data data_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_LINCONTROLLER_HPP_
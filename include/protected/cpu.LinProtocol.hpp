@@ -0,0 +1,82 @@
+/**
+ * @file      cpu.LinProtocol.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_LINPROTOCOL_HPP_
+#define CPU_LINPROTOCOL_HPP_
+
+#include "cpu.Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class LinProtocol
+ * @brief LIN protected identifier and checksum calculator.
+ *
+ * A protected identifier is a 6 bits frame identifier with parity bits P0 = ID0 ^ ID1 ^ ID2 ^ ID4
+ * and P1 = ~(ID1 ^ ID3 ^ ID4 ^ ID5) in its two MSBs. A checksum is the inverted eight bit sum
+ * with carry of data bytes, and the enhanced checksum also includes the protected identifier.
+ */
+class LinProtocol
+{
+
+public:
+
+    /**
+     * @brief Sync field value.
+     */
+    static const uint8_t SYNC = 0x55;
+
+    /**
+     * @brief Number of frame identifiers.
+     */
+    static const uint8_t NUMBER_OF_IDS = 64;
+
+    /**
+     * @brief Maximal number of data bytes of a frame.
+     */
+    static const uint8_t DATA_SIZE = 8;
+
+    /**
+     * @brief Returns the protected identifier of a frame identifier.
+     *
+     * @param id A frame identifier.
+     * @return The protected identifier.
+     */
+    static uint8_t getPid(uint8_t id);
+
+    /**
+     * @brief Tests if a protected identifier has correct parity bits.
+     *
+     * @param pid A protected identifier.
+     * @return True if it is correct.
+     */
+    static bool_t isPid(uint8_t pid);
+
+    /**
+     * @brief Calculates a frame checksum.
+     *
+     * @param pid      A protected identifier.
+     * @param data     Data bytes.
+     * @param size     Number of data bytes.
+     * @param enhanced True for the enhanced checksum, which is never used for diagnostic frames.
+     * @return The checksum.
+     */
+    static uint8_t getChecksum(uint8_t pid, const uint8_t* data, size_t size, bool_t enhanced);
+
+private:
+
+    /**
+     * @brief Protected identifiers of frame identifiers.
+     */
+    static const uint8_t PID[NUMBER_OF_IDS];
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_LINPROTOCOL_HPP_
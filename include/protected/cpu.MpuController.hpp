@@ -0,0 +1,206 @@
+/**
+ * @file      cpu.MpuController.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_MPUCONTROLLER_HPP_
+#define CPU_MPUCONTROLLER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "api.Runnable.hpp"
+#include "cpu.Registers.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class MpuController
+ * @brief CPU HW memory protection unit controller.
+ *
+ * The controller guards the bottom of thread stacks by a no-access MPU region.
+ * The region is a part of a thread context, which is saved and loaded on
+ * a task switch, and a stack overflow causes MemManage fault, which is
+ * reported through the controller. The kernel port sets the guard of each thread
+ * by CpuMpuController_setStackGuard() after the thread stack is initialized.
+ *
+ * @note The guard is available only if EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD is defined.
+ */
+class MpuController : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @enum Fault
+     * @brief MemManage fault reasons.
+     */
+    enum Fault
+    {
+        FAULT_NONE = 0,     ///< No fault happened
+        FAULT_OVERFLOW,     ///< A thread accessed its stack guard
+        FAULT_STACKING,     ///< Exception entry stacking overflowed a thread stack
+        FAULT_OTHER         ///< Other MemManage fault
+    };
+
+    /**
+     * @struct Report
+     * @brief MemManage fault report.
+     */
+    struct Report
+    {
+        /**
+         * @brief Fault reason.
+         */
+        Fault fault;
+
+        /**
+         * @brief Fault address if it is valid, or zero.
+         */
+        uint32_t address;
+
+        /**
+         * @brief Stack guard base address of the faulted thread.
+         */
+        uint32_t guard;
+
+        /**
+         * @brief TCB of the faulted thread.
+         */
+        void* tcb;
+
+        /**
+         * @brief Configurable fault status register value.
+         */
+        uint32_t cfsr;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     */
+    MpuController(Registers& reg, api::Guard& gie);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~MpuController();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Sets a stack guard region to a thread context.
+     *
+     * The guard is the lowest aligned block of GUARD_SIZE bytes of the stack.
+     *
+     * @param sp    Stack pointer returned by CpuRegistersController::initializeStack().
+     * @param stack Lowest address of the thread stack.
+     * @return True if the guard is set.
+     */
+    bool_t setStackGuard(void* sp, void* stack);
+
+    /**
+     * @brief Sets a handler of a thread stack overflow.
+     *
+     * The handler is called in MemManage exception context after a report is done.
+     * If the handler is not set or returns, the CPU is halted.
+     *
+     * @param handler A stack overflow handler or a null pointer.
+     */
+    void setOverflowHandler(api::Runnable* handler);
+
+    /**
+     * @brief Returns the last MemManage fault report.
+     *
+     * @return The report.
+     */
+    const Report& getReport() const;
+
+    /**
+     * @brief Sets a stack guard region to a thread context by the constructed controller.
+     *
+     * @param sp    Stack pointer returned by CpuRegistersController::initializeStack().
+     * @param stack Lowest address of the thread stack.
+     * @return True if the guard is set.
+     */
+    static bool_t setGuard(void* sp, void* stack);
+
+    /**
+     * @brief Handles MemManage fault.
+     */
+    static void handleFault();
+
+    /**
+     * @brief Guard region number.
+     */
+    static const uint32_t GUARD_REGION = 7;
+
+    /**
+     * @brief Guard region size in bytes.
+     */
+    static const uint32_t GUARD_SIZE = EOOS_GLOBAL_CPU_STACK_GUARD_SIZE;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the MPU.
+     *
+     * @return True if initialized.
+     */
+    bool_t initialize();
+
+    /**
+     * @brief Deinitializes the MPU.
+     */
+    void deinitialize();
+
+    /**
+     * @brief Halts the CPU.
+     */
+    void halt();
+
+    /**
+     * @brief This object.
+     */
+    static MpuController* this_;
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Stack overflow handler.
+     */
+    api::Runnable* handler_;
+
+    /**
+     * @brief Last fault report.
+     */
+    Report report_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_MPUCONTROLLER_HPP_
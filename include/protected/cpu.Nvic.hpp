@@ -0,0 +1,160 @@
+/**
+ * @file      cpu.Nvic.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_NVIC_HPP_
+#define CPU_NVIC_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Nvic
+ * @brief CPU HW nested vectored interrupt controller.
+ *
+ * The NVIC ISER and ICER registers change only bits written with 1,
+ * thus an IRQ is enabled or disabled by one store without reading
+ * a register and masking interrupts.
+ */
+class Nvic : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Number of IRQs of STM32F103xx like XL-density (Non-connectivity) devices.
+     */
+    static const int32_t NUMBER_OF_IRQS = 60;
+
+    /**
+     * @brief Number of words to keep one bit for each IRQ.
+     */
+    static const int32_t NUMBER_OF_WORDS = (NUMBER_OF_IRQS + 31) / 32;
+
+    /**
+     * @struct Mask
+     * @brief Bitmap of IRQs.
+     */
+    struct Mask
+    {
+        /**
+         * @brief Constructor of an empty bitmap.
+         */
+        Mask();
+
+        /**
+         * @brief Adds an IRQ to the bitmap.
+         *
+         * @param irq An IRQ number.
+         * @return True if the IRQ is added.
+         */
+        bool_t add(int32_t irq);
+
+        /**
+         * @brief IRQ bits.
+         */
+        uint32_t word[NUMBER_OF_WORDS];
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     */
+    Nvic(Registers& reg, api::Guard& gie);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Nvic();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Enables an IRQ.
+     *
+     * @param irq An IRQ number.
+     */
+    void enable(int32_t irq);
+
+    /**
+     * @brief Disables an IRQ.
+     *
+     * @param irq An IRQ number.
+     */
+    void disable(int32_t irq);
+
+    /**
+     * @brief Enables IRQs of a bitmap in one guarded section.
+     *
+     * @param mask A bitmap of IRQs.
+     */
+    void enable(const Mask& mask);
+
+    /**
+     * @brief Disables IRQs of a bitmap in one guarded section.
+     *
+     * @param mask A bitmap of IRQs.
+     */
+    void disable(const Mask& mask);
+
+    /**
+     * @brief Tests if an IRQ number is valid.
+     *
+     * @param irq An IRQ number.
+     * @return True if it is valid.
+     */
+    static bool_t isIrq(int32_t irq);
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Returns a bit of an IRQ in its register.
+     *
+     * @param irq An IRQ number.
+     * @return The bit value.
+     */
+    static uint32_t getBit(int32_t irq);
+
+    /**
+     * @brief Returns a register index of an IRQ.
+     *
+     * @param irq An IRQ number.
+     * @return The register index.
+     */
+    static int32_t getIndex(int32_t irq);
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_NVIC_HPP_
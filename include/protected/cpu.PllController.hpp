@@ -53,6 +53,41 @@ public:
      * @copydoc eoos::api::CpuPllController::getCpuClock()
      */  
     virtual int64_t getCpuClock();
+
+    /**
+     * @brief Returns the system clock computed from the current RCC configuration.
+     *
+     * @return SYSCLK in Hz.
+     */
+    int64_t getSystemClock() const;
+
+    /**
+     * @brief Returns the AHB clock computed from the current RCC configuration.
+     *
+     * @return HCLK in Hz.
+     */
+    int64_t getAhbClock() const;
+
+    /**
+     * @brief Returns the APB1 clock computed from the current RCC configuration.
+     *
+     * @return PCLK1 in Hz.
+     */
+    int64_t getApb1Clock() const;
+
+    /**
+     * @brief Returns the APB2 clock computed from the current RCC configuration.
+     *
+     * @return PCLK2 in Hz.
+     */
+    int64_t getApb2Clock() const;
+
+    /**
+     * @brief Restores SYSCLK from PLL after the stop mode, which wakes the CPU up clocked by HSI.
+     *
+     * @return True if SYSCLK is restored.
+     */
+    bool_t resume();
     
 private:
 
@@ -79,6 +114,24 @@ private:
      * all the divs and muls for all avalable SYSCLKs can be given as argument.
      */    
     bool_t setSysClkTo72();
+
+    /**
+     * @brief Returns an APB clock divided from HCLK.
+     *
+     * @param ppre A PPRE1 or PPRE2 value of RCC_CFGR.
+     * @return PCLK in Hz.
+     */
+    int64_t getApbClock(uint32_t ppre) const;
+
+    /**
+     * @brief HSI clock frequency.
+     */
+    static const int64_t HSI_CLOCK = 8000000;
+
+    /**
+     * @brief HSE clock frequency.
+     */
+    static const int64_t HSE_CLOCK = 8000000;
     
     /**
      * @brief HSERDY bit waitting timeout.
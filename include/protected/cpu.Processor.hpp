@@ -14,6 +14,13 @@
 #include "cpu.PllController.hpp"
 #include "cpu.InterruptController.hpp"
 #include "cpu.TimerController.hpp"
+#include "cpu.MpuController.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.Dma.hpp"
+#include "cpu.UsartController.hpp"
+#include "cpu.LinController.hpp"
+#include "cpu.CanController.hpp"
+#include "cpu.CycleCounter.hpp"
 
 namespace eoos
 {
@@ -80,6 +87,41 @@ public:
      */
     virtual api::CpuTimerController& getTimerController();
 
+    /**
+     * @brief Returns the target CPU memory protection unit controller.
+     *
+     * @return The MPU controller.
+     */
+    MpuController& getMpuController();
+
+    /**
+     * @brief Returns the target CPU USART controller.
+     *
+     * @return The USART controller.
+     */
+    UsartController& getUsartController();
+
+    /**
+     * @brief Returns the target CPU LIN controller.
+     *
+     * @return The LIN controller.
+     */
+    LinController& getLinController();
+
+    /**
+     * @brief Returns the target CPU CAN controller.
+     *
+     * @return The CAN controller.
+     */
+    CanController& getCanController();
+
+    /**
+     * @brief Returns the target CPU clock cycle counter.
+     *
+     * @return The cycle counter.
+     */
+    CycleCounter& getCycleCounter();
+
 private:
 
     /**
@@ -119,6 +161,41 @@ private:
      */
     TimerController tim_;
 
+    /**
+     * @brief Target CPU memory protection unit controller.
+     */
+    MpuController mpu_;
+
+    /**
+     * @brief Target CPU general-purpose input output pins.
+     */
+    Gpio gpio_;
+
+    /**
+     * @brief Target CPU direct memory access channels.
+     */
+    Dma dma_;
+
+    /**
+     * @brief Target CPU USART controller.
+     */
+    UsartController usart_;
+
+    /**
+     * @brief Target CPU LIN controller.
+     */
+    LinController lin_;
+
+    /**
+     * @brief Target CPU CAN controller.
+     */
+    CanController can_;
+
+    /**
+     * @brief Target CPU clock cycle counter.
+     */
+    CycleCounter cyc_;
+
 };
 
 } // namespace cpu
@@ -9,13 +9,20 @@
 #include "cpu.reg.Usart.hpp"
 #include "cpu.reg.Can.hpp"
 #include "cpu.reg.Gpio.hpp"
+#include "cpu.reg.Dma.hpp"
+#include "cpu.reg.Tim.hpp"
 #include "cpu.reg.Rcc.hpp"
+#include "cpu.reg.Pwr.hpp"
+#include "cpu.reg.Exti.hpp"
 #include "cpu.reg.Flash.hpp"
 #include "cpu.reg.Auxiliary.hpp"
 #include "cpu.reg.SysTick.hpp"
 #include "cpu.reg.Nvic.hpp"
 #include "cpu.reg.Scb.hpp"
+#include "cpu.reg.Mpu.hpp"
 #include "cpu.reg.Dbg.hpp"
+#include "cpu.reg.Dwt.hpp"
+#include "cpu.reg.CoreDebug.hpp"
 
 namespace eoos
 {
@@ -57,6 +64,18 @@ struct Registers
     static const int32_t INDEX_GPIOD = 3;
     static const int32_t INDEX_GPIOE = 4;    
 
+    /**
+     * @brief Index DMA.
+     */    
+    static const int32_t INDEX_DMA1 = 0;
+    static const int32_t INDEX_DMA2 = 1;
+
+    /**
+     * @brief Index basic TIM.
+     */
+    static const int32_t INDEX_TIM6 = 0;
+    static const int32_t INDEX_TIM7 = 1;
+
     /**
      * @brief Universal Synchronous Asynchronous Transceiver (USART).
      *
@@ -87,11 +106,39 @@ struct Registers
      */
     reg::Gpio* gpio[5];
 
+    /**
+     * @brief Direct Memory Access controller (DMA).
+     *
+     * DMA1: 0x40020000 - 0x400203FF;
+     * DMA2: 0x40020400 - 0x400207FF;
+     */
+    reg::Dma* dma[2];
+
+    /**
+     * @brief Basic timers (TIM).
+     *
+     * TIM6: 0x40001000 - 0x400013FF;
+     * TIM7: 0x40001400 - 0x400017FF;
+     */
+    reg::Tim* tim[2];
+
     /**
      * @brief Reset and Clock Control.
      * 0x40021000 - 0x400213FF
      */    
     reg::Rcc* rcc;    
+
+    /**
+     * @brief Power control.
+     * 0x40007000 - 0x400073FF
+     */
+    reg::Pwr* pwr;
+
+    /**
+     * @brief External interrupt/event controller.
+     * 0x40010400 - 0x400107FF
+     */
+    reg::Exti* exti;
     
     /**
      * @brief Flash Memory Interface/Cache.
@@ -105,6 +152,12 @@ struct Registers
      */
     reg::Dbg* dbg;    
 
+    /**
+     * @brief Data Watchpoint and Trace unit.
+     * 0xE0001000 - 0xE0001FFF
+     */
+    reg::Dwt* dwt;
+
     /**
      * @brief System Control Space.
      * 0xE000E000 - 0xE000EFFF
@@ -139,6 +192,18 @@ struct Registers
          * 0xE000ED00 - 0xE000ED8F
          */    
         reg::Scb* scb;
+
+        /**
+         * @brief Memory Protection Unit.
+         * 0xE000ED90 - 0xE000EDB8
+         */    
+        reg::Mpu* mpu;
+
+        /**
+         * @brief Debug registers.
+         * 0xE000EDF0 - 0xE000EEFF
+         */    
+        reg::CoreDebug* debug;
         
     } scs;
     
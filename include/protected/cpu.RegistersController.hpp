@@ -43,6 +43,10 @@ public:
         
     /**
      * @copydoc eoos::api::CpuRegistersController::initializeStack()
+     *
+     * @note If EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD is defined, the initial context has 
+     *       the stack guard region disabled, and the kernel port sets it by
+     *       CpuMpuController_setStackGuard().
      */
     virtual void* initializeStack(void* stack, void* entry, void* exit, int32_t argument);
 
@@ -0,0 +1,349 @@
+/**
+ * @file      cpu.RingBuffer.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_RINGBUFFER_HPP_
+#define CPU_RINGBUFFER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class RingBuffer
+ * @brief Lock-free single producer single consumer ring buffer.
+ *
+ * The producer changes only the head index and the consumer changes only the tail index,
+ * thus a thread and an ISR can exchange elements without interrupts masking. Both indexes
+ * are free-running, and the buffer size is a power of two to wrap them with a mask.
+ *
+ * @tparam T Integral type of an element.
+ */
+template <typename T>
+class RingBuffer : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param buffer A memory of elements.
+     * @param size   Number of elements of the memory, which is a power of two.
+     */
+    RingBuffer(T* buffer, size_t size);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~RingBuffer();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Puts an element to the head.
+     *
+     * @param element An element.
+     * @return True if the element is put.
+     */
+    bool_t push(T element);
+
+    /**
+     * @brief Gets an element from the tail.
+     *
+     * @param element An element.
+     * @return True if the element is got.
+     */
+    bool_t pop(T& element);
+
+    /**
+     * @brief Puts elements to the head.
+     *
+     * @param elements Elements.
+     * @param number   Number of the elements.
+     * @return Number of put elements.
+     */
+    size_t write(const T* elements, size_t number);
+
+    /**
+     * @brief Gets elements from the tail.
+     *
+     * @param elements Elements.
+     * @param number   Maximum number of the elements.
+     * @return Number of got elements.
+     */
+    size_t read(T* elements, size_t number);
+
+    /**
+     * @brief Moves the head forward to an element index of the memory.
+     *
+     * The function is used by a producer which puts elements to the memory itself, like DMA does,
+     * thus a producer which puts more elements than the buffer size at once is not detected. If the
+     * head passes the tail by more than the buffer size, the elements are overwritten, and the
+     * consumer calls dropOverrun() to discard them.
+     *
+     * @param index An element index of the memory which the producer puts a next element to.
+     */
+    void advanceHead(size_t index);
+
+    /**
+     * @brief Discards all elements if the producer has overwritten unread ones.
+     *
+     * The function is called by the consumer, and it moves the tail to the head.
+     *
+     * @return Number of discarded elements, or zero if elements are not overwritten.
+     */
+    size_t dropOverrun();
+
+    /**
+     * @brief Returns number of elements in the buffer.
+     *
+     * @return Number of elements.
+     */
+    size_t getLength() const;
+
+    /**
+     * @brief Returns number of elements which can be put.
+     *
+     * @return Number of free elements.
+     */
+    size_t getFree() const;
+
+    /**
+     * @brief Returns number of elements of the buffer.
+     *
+     * @return Capacity of the buffer.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Returns number of elements put since the buffer construction.
+     *
+     * @return Number of elements modulo 2^32.
+     */
+    uint32_t getPushed() const;
+
+    /**
+     * @brief Returns number of elements got since the buffer construction.
+     *
+     * @return Number of elements modulo 2^32.
+     */
+    uint32_t getPopped() const;
+
+    /**
+     * @brief Tests if a number is a power of two.
+     *
+     * @param number A number.
+     * @return True if it is.
+     */
+    static bool_t isPowerOfTwo(size_t number);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Memory of elements.
+     */
+    T volatile* buffer_;
+
+    /**
+     * @brief Mask to wrap an index.
+     */
+    uint32_t mask_;
+
+    /**
+     * @brief Free-running index to put an element.
+     */
+    uint32_t volatile head_;
+
+    /**
+     * @brief Free-running index to get an element.
+     */
+    uint32_t volatile tail_;
+
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(T* buffer, size_t size)
+    : NonCopyable<NoAllocator>()
+    , buffer_( buffer )
+    , mask_( static_cast<uint32_t>(size) - 1U )
+    , head_( 0 )
+    , tail_( 0 ) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+template <typename T>
+RingBuffer<T>::~RingBuffer()
+{
+}
+
+template <typename T>
+bool_t RingBuffer<T>::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+template <typename T>
+bool_t RingBuffer<T>::push(T element)
+{
+    uint32_t const head( head_ );
+    if( head - tail_ > mask_ )
+    {
+        return false;
+    }
+    buffer_[head & mask_] = element;
+    head_ = head + 1U;
+    return true;
+}
+
+template <typename T>
+bool_t RingBuffer<T>::pop(T& element)
+{
+    uint32_t const tail( tail_ );
+    if( tail == head_ )
+    {
+        return false;
+    }
+    element = buffer_[tail & mask_];
+    tail_ = tail + 1U;
+    return true;
+}
+
+template <typename T>
+size_t RingBuffer<T>::write(const T* elements, size_t number)
+{
+    uint32_t head( head_ );
+    uint32_t const free( mask_ + 1U - (head - tail_) );
+    size_t const count( (number < free) ? number : free );
+    for(size_t i(0U); i<count; i++)
+    {
+        buffer_[head & mask_] = elements[i];
+        head++;
+    }
+    head_ = head;
+    return count;
+}
+
+template <typename T>
+size_t RingBuffer<T>::read(T* elements, size_t number)
+{
+    uint32_t tail( tail_ );
+    uint32_t length( head_ - tail );
+    if( length > mask_ + 1U )
+    {
+        length = 0U;
+    }
+    size_t const count( (number < length) ? number : length );
+    for(size_t i(0U); i<count; i++)
+    {
+        elements[i] = buffer_[tail & mask_];
+        tail++;
+    }
+    tail_ = tail;
+    return count;
+}
+
+template <typename T>
+void RingBuffer<T>::advanceHead(size_t index)
+{
+    uint32_t const head( head_ );
+    head_ = head + ( (static_cast<uint32_t>(index) - head) & mask_ );
+}
+
+template <typename T>
+size_t RingBuffer<T>::dropOverrun()
+{
+    uint32_t const head( head_ );
+    uint32_t const length( head - tail_ );
+    if( length <= mask_ + 1U )
+    {
+        return 0U;
+    }
+    tail_ = head;
+    return length;
+}
+
+template <typename T>
+size_t RingBuffer<T>::getLength() const
+{
+    // The head of an overrun producer is more than the buffer size ahead of the tail
+    uint32_t const length( head_ - tail_ );
+    return ( length <= mask_ ) ? length : mask_ + 1U;
+}
+
+template <typename T>
+size_t RingBuffer<T>::getFree() const
+{
+    return mask_ + 1U - getLength();
+}
+
+template <typename T>
+size_t RingBuffer<T>::getCapacity() const
+{
+    return mask_ + 1U;
+}
+
+template <typename T>
+uint32_t RingBuffer<T>::getPushed() const
+{
+    return head_;
+}
+
+template <typename T>
+uint32_t RingBuffer<T>::getPopped() const
+{
+    return tail_;
+}
+
+template <typename T>
+bool_t RingBuffer<T>::isPowerOfTwo(size_t number)
+{
+    return number != 0U && (number & (number - 1U)) == 0U;
+}
+
+template <typename T>
+bool_t RingBuffer<T>::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( buffer_ == NULLPTR )
+        {
+            break;
+        }
+        if( !isPowerOfTwo(mask_ + 1U) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_RINGBUFFER_HPP_
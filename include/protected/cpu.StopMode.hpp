@@ -0,0 +1,97 @@
+/**
+ * @file      cpu.StopMode.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_STOPMODE_HPP_
+#define CPU_STOPMODE_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.CanController.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class StopMode
+ * @brief CPU stop mode woken up by CAN bus activity.
+ *
+ * The CAN controller is put to the sleep mode and the CPU is stopped with the voltage regulator in
+ * the low-power mode. The clocks of the CAN controller are stopped as well, thus the CAN RX pin
+ * is an EXTI event line which falling edge of SOF wakes the CPU up. After the wake-up SYSCLK is
+ * restored from PLL and the CAN controller is woken up at once, thus it is synchronized to the
+ * bus before the frame which has woken the CPU up ends and receives the next frame.
+ *
+ * @note The frame which wakes the CPU up is lost, as the CPU is stopped on its SOF.
+ * @note The EXTI line 11 must not be remapped by AFIO from PA11.
+ */
+class StopMode : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg Target CPU register model.
+     * @param gie Global interrupt enable controller.
+     * @param pll PLL controller.
+     */
+    StopMode(Registers& reg, api::Guard& gie, PllController& pll);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~StopMode();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Stops the CPU until CAN bus activity.
+     *
+     * @param can A CAN resource to wake up on.
+     * @return True if the CPU has been stopped and the CAN resource is synchronized to the bus, or
+     *         false if the CAN resource cannot sleep as frames are pending.
+     */
+    bool_t enter(CanController::Resource& can);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @brief EXTI line of the CAN RX pin PA11.
+     */
+    static const int32_t CAN_RX_LINE = 11;
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief PLL controller.
+     */
+    PllController& pll_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_STOPMODE_HPP_
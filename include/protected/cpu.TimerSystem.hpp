@@ -21,6 +21,8 @@ namespace cpu
 /**
  * @class TimerSystem
  * @brief CPU HW system timer (SysTick) resource.
+ *
+ * @note SysTick registers are not in a bit-band region, thus their bits are changed in guarded sections.
  * 
  * @tparam A Heap memory allocator class.
  */
@@ -0,0 +1,315 @@
+/**
+ * @file      cpu.Trace.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_TRACE_HPP_
+#define CPU_TRACE_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.Guard.hpp"
+#include "api.Runnable.hpp"
+#include "cpu.CycleCounter.hpp"
+#include "cpu.UsartController.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Trace
+ * @brief Binary event trace sink over USART transmitted by DMA.
+ *
+ * An event is put to one of two buffers of fixed size records, which are for Thread and Handler
+ * modes, by reserving a record with LDREX and STREX and writing its header last. Thus, any context
+ * puts an event without interrupts masking and the drain() function sends ready records to the
+ * USART directly from the buffers. If a buffer is full, the event is counted as lost and the counter
+ * is sent later as an EVENT_LOST event.
+ *
+ * @note The USART resource must be created with TX DMA.
+ */
+class Trace : public NonCopyable<NoAllocator>, public api::Runnable
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief Event identifier of lost events which arguments are the number of lost events.
+     */
+    static const uint16_t EVENT_LOST = 0xFFFF;
+
+    /**
+     * @brief Synchronization byte of a record header.
+     */
+    static const uint32_t SYNC = 0xA5;
+
+    /**
+     * @enum Context
+     * @brief CPU execution mode of an event.
+     */
+    enum Context
+    {
+        CONTEXT_THREAD = 0,
+        CONTEXT_HANDLER = 1
+    };
+
+    /**
+     * @struct Record
+     * @brief Binary record transmitted in little-endian byte order.
+     *
+     * The header is SYNC in bits 31-24, the context in bit 18, the number of arguments in
+     * bits 17-16 and the event identifier in bits 15-0. The time is the CPU clock cycles.
+     */
+    struct Record
+    {
+        uint32_t header;
+        uint32_t time;
+        uint32_t arg[3];
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param usart       USART resource with TX DMA.
+     * @param cyc         CPU clock cycle counter.
+     * @param gie         Global interrupt enable controller.
+     * @param thread      Buffer of Thread mode records.
+     * @param threadSize  Number of Thread mode records, which is a power of two.
+     * @param handler     Buffer of Handler mode records.
+     * @param handlerSize Number of Handler mode records, which is a power of two.
+     */
+    Trace(UsartController::Resource& usart, CycleCounter& cyc, api::Guard& gie, Record* thread, size_t threadSize, Record* handler, size_t handlerSize);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Trace();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Handles completion of records transmission.
+     */
+    virtual void start();
+
+    /**
+     * @brief Starts transmission of ready records if the previous one is completed.
+     */
+    void drain();
+
+    /**
+     * @brief Returns number of lost events.
+     *
+     * @param context A context of events.
+     * @return Number of events.
+     */
+    uint32_t getLost(Context context) const;
+
+    /**
+     * @brief Puts an event.
+     *
+     * @param id An event identifier.
+     */
+    static void write(uint16_t id);
+
+    /**
+     * @brief Puts an event.
+     *
+     * @param id An event identifier.
+     * @param a0 The first argument.
+     */
+    static void write(uint16_t id, uint32_t a0);
+
+    /**
+     * @brief Puts an event.
+     *
+     * @param id An event identifier.
+     * @param a0 The first argument.
+     * @param a1 The second argument.
+     */
+    static void write(uint16_t id, uint32_t a0, uint32_t a1);
+
+    /**
+     * @brief Puts an event.
+     *
+     * @param id An event identifier.
+     * @param a0 The first argument.
+     * @param a1 The second argument.
+     * @param a2 The third argument.
+     */
+    static void write(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2);
+
+    /**
+     * @brief Puts USART statistics as three events.
+     *
+     * The events have consecutive identifiers from the given one, and their arguments are
+     * rxBytes, txBytes and rxDropped, then overrun, framing and noise, and then parity,
+     * rxHighWater and isrCycles.
+     *
+     * @param id         The first event identifier.
+     * @param statistics USART statistics.
+     */
+    static void write(uint16_t id, const UsartController::Resource::Statistics& statistics);
+
+private:
+
+    /**
+     * @brief Number of contexts.
+     */
+    static const int32_t NUMBER_OF_CONTEXTS = 2;
+
+    /**
+     * @struct Buffer
+     * @brief Records buffer of a context.
+     */
+    struct Buffer
+    {
+        /**
+         * @brief Constructor of an empty buffer.
+         */
+        Buffer();
+
+        /**
+         * @brief Records.
+         */
+        Record volatile* record;
+
+        /**
+         * @brief Number of records.
+         */
+        uint32_t size;
+
+        /**
+         * @brief Free-running index of the next record to reserve.
+         */
+        uint32_t volatile head;
+
+        /**
+         * @brief Free-running index of the next record to transmit.
+         */
+        uint32_t volatile tail;
+
+        /**
+         * @brief Number of lost events.
+         */
+        uint32_t volatile lost;
+
+        /**
+         * @brief Number of lost events put to the buffer as EVENT_LOST events.
+         */
+        uint32_t reported;
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @param thread      Buffer of Thread mode records.
+     * @param threadSize  Number of Thread mode records.
+     * @param handler     Buffer of Handler mode records.
+     * @param handlerSize Number of Handler mode records.
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct(Record* thread, size_t threadSize, Record* handler, size_t handlerSize);
+
+    /**
+     * @brief Puts an event to a buffer of the current context.
+     *
+     * @param id    An event identifier.
+     * @param count Number of arguments.
+     * @param a0    The first argument.
+     * @param a1    The second argument.
+     * @param a2    The third argument.
+     */
+    static void put(uint16_t id, uint32_t count, uint32_t a0, uint32_t a1, uint32_t a2);
+
+    /**
+     * @brief Puts an event to a buffer.
+     *
+     * @param context A context of the buffer.
+     * @param id      An event identifier.
+     * @param count   Number of arguments.
+     * @param a0      The first argument.
+     * @param a1      The second argument.
+     * @param a2      The third argument.
+     * @return True if the event is put.
+     */
+    bool_t putEvent(int32_t context, uint16_t id, uint32_t count, uint32_t a0, uint32_t a1, uint32_t a2);
+
+    /**
+     * @brief Puts a lost events counter of a buffer to the buffer.
+     *
+     * @param context A context of the buffer.
+     */
+    void putLost(int32_t context);
+
+    /**
+     * @brief Starts transmission of ready records of a buffer.
+     *
+     * @param context A context of the buffer.
+     * @return True if the transmission is started.
+     */
+    bool_t send(int32_t context);
+
+    /**
+     * @brief Tests if a value is a power of two.
+     *
+     * @param value A value.
+     * @return True if the value is a power of two.
+     */
+    static bool_t isPowerOfTwo(size_t value);
+
+    /**
+     * @brief This object.
+     */
+    static Trace* this_;
+
+    /**
+     * @brief USART resource.
+     */
+    UsartController::Resource& usart_;
+
+    /**
+     * @brief CPU clock cycle counter.
+     */
+    CycleCounter& cyc_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Records buffers of contexts.
+     */
+    Buffer buffer_[NUMBER_OF_CONTEXTS];
+
+    /**
+     * @brief Transfer of records.
+     */
+    UsartController::Resource::Transfer transfer_;
+
+    /**
+     * @brief Context of the buffer being transmitted.
+     */
+    int32_t context_;
+
+    /**
+     * @brief Number of records being transmitted.
+     */
+    uint32_t sending_;
+
+    /**
+     * @brief The transmission is in progress.
+     */
+    bool_t isBusy_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_TRACE_HPP_
@@ -0,0 +1,1638 @@
+/**
+ * @file      cpu.Usart.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_USART_HPP_
+#define CPU_USART_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "api.Runnable.hpp"
+#include "api.Guard.hpp"
+#include "cpu.Registers.hpp"
+#include "cpu.Interrupt.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.Dma.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.UsartBaud.hpp"
+#include "cpu.BitBand.hpp"
+#include "cpu.RingBuffer.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class Usart
+ * @brief CPU HW USART resource.
+ *
+ * The resource receives and transmits bytes in its interrupt handler. Received bytes are put to
+ * a RX ring buffer on RXNE, and bytes to transmit are got from a TX ring buffer on TXE, therefore
+ * the read and write functions never wait for the hardware. Each ring buffer has one producer
+ * and one consumer, so the buffers are changed without interrupts masking, and TXEIE bit is
+ * changed through its bit-band alias.
+ *
+ * If RX DMA is configured, a DMA channel receives bytes to the RX ring buffer memory in circular mode,
+ * and the RX ring buffer head is moved to the DMA position on IDLE line, half transfer and transfer
+ * complete interrupts, thus the CPU is interrupted once per a frame burst instead of once per a byte.
+ *
+ * If TX DMA is configured, caller owned buffers are queued by their transfer descriptors, and
+ * a DMA channel transmits them one by one directly from the buffers. The channel is reloaded with
+ * a next queued transfer on the transfer complete interrupt, and a completed transfer is returned
+ * to the caller through its handler.
+ *
+ * If a RS-485 driver enable pin is configured, the pin is set before a first byte is transmitted,
+ * and it is reset in the interrupt handler on the transmission complete flag after the last byte,
+ * thus the bus is released in the stop bit time of the last byte.
+ *
+ * If hardware flow control is configured, RTS is deasserted while DR holds a received byte, and
+ * the interrupt handler leaves a byte in DR if the RX ring buffer is full, thus a transmitter is
+ * stopped until read() frees the buffer instead of a byte is lost on overrun.
+ *
+ * Statistics counters are updated in the interrupt handlers without interrupts masking, as each
+ * counter is a word written only by one of the handlers.
+ *
+ * If a wake-up method is configured, the receiver can be put to mute mode, in which the hardware
+ * discards received frames without setting any flags, thus the CPU is not interrupted by frames
+ * addressed to other nodes of a multi-drop bus.
+ *
+ * @note The resource uses one Interrupt resource of InterruptController, and one more for each DMA.
+ *
+ * @tparam A Heap memory allocator class.
+ */
+template <class A>
+class Usart : public NonCopyable<A>, public api::Runnable
+{
+    typedef NonCopyable<A> Parent;
+
+public:
+
+    /**
+     * @enum Parity
+     * @brief Parity control.
+     */
+    enum Parity
+    {
+        PARITY_NONE = 0, ///< 8 data bits without parity bit
+        PARITY_EVEN,     ///< 8 data bits and even parity bit
+        PARITY_ODD       ///< 8 data bits and odd parity bit
+    };
+
+    /**
+     * @enum StopBits
+     * @brief Number of stop bits as CR2 STOP bits.
+     */
+    enum StopBits
+    {
+        STOP_BITS_1   = 0, ///< 1 stop bit
+        STOP_BITS_0_5 = 1, ///< 0.5 stop bit
+        STOP_BITS_2   = 2, ///< 2 stop bits
+        STOP_BITS_1_5 = 3  ///< 1.5 stop bits
+    };
+
+    /**
+     * @enum Wake
+     * @brief Wake-up method from mute mode.
+     */
+    enum Wake
+    {
+        WAKE_NONE = 0,     ///< Mute mode is not used
+        WAKE_IDLE_LINE,    ///< Wake up on idle line, and mute() is called for frames of other nodes
+        WAKE_ADDRESS_MARK  ///< Wake up on a word which MSB is set and which LSBs are the node address
+    };
+
+    /**
+     * @struct Config
+     * @brief USART configuration.
+     */
+    struct Config
+    {
+        /**
+         * @brief Constructor of default configuration.
+         */
+        Config();
+
+        /**
+         * @brief Baud rate.
+         */
+        int32_t baud;
+
+        /**
+         * @brief Baud rate register value, or zero to calculate it for the baud rate from the USART bus clock.
+         */
+        uint32_t brr;
+
+        /**
+         * @brief Parity control.
+         */
+        Parity parity;
+
+        /**
+         * @brief Number of stop bits.
+         */
+        StopBits stopBits;
+
+        /**
+         * @brief RX ring buffer memory.
+         */
+        uint8_t* rxBuffer;
+
+        /**
+         * @brief RX ring buffer size in bytes, which is a power of two.
+         */
+        size_t rxSize;
+
+        /**
+         * @brief Receive by DMA in circular mode to the RX ring buffer memory.
+         *
+         * @note UART5 has no DMA request, thus it receives bytes on RXNE.
+         */
+        bool_t rxDma;
+
+        /**
+         * @brief Handler of a received frame end, which is IDLE line, or a null pointer.
+         *
+         * @note The handler is called in the USART interrupt context.
+         */
+        api::Runnable* rxHandler;
+
+        /**
+         * @brief Transmit by DMA from caller owned buffers, which are sent by send() function.
+         *
+         * @note UART5 has no DMA request.
+         */
+        bool_t txDma;
+
+        /**
+         * @brief TX ring buffer memory, which is not used if TX DMA is configured.
+         */
+        uint8_t* txBuffer;
+
+        /**
+         * @brief TX ring buffer size in bytes, which is a power of two.
+         */
+        size_t txSize;
+
+        /**
+         * @brief RS-485 transceiver driver enable pin, which is high while transmitting, or an invalid pin.
+         */
+        Gpio::Pin de;
+
+        /**
+         * @brief Wake-up method from mute mode.
+         */
+        Wake wake;
+
+        /**
+         * @brief Node address of 4 bits for address mark wake-up.
+         *
+         * @note The receiver starts in mute mode and the hardware mutes it again on a word
+         *       which address does not match, thus data words have their MSB cleared.
+         */
+        uint8_t address;
+
+        /**
+         * @brief Hardware RTS and CTS flow control.
+         *
+         * @note UART4 and UART5 have no RTS and CTS. With RX DMA, the DMA channel keeps DR read,
+         *       thus RTS prevents overruns of DR but not of the RX ring buffer.
+         */
+        bool_t flowControl;
+    };
+
+    /**
+     * @struct Transfer
+     * @brief Transfer descriptor of a caller owned buffer to transmit by DMA.
+     *
+     * A descriptor and its buffer are owned by the resource from they are sent
+     * until the descriptor handler is called.
+     */
+    struct Transfer
+    {
+        /**
+         * @brief Constructor of an empty transfer.
+         */
+        Transfer();
+
+        /**
+         * @brief Buffer to transmit.
+         */
+        const void* data;
+
+        /**
+         * @brief Number of bytes to transmit, which is not more than 65535.
+         */
+        size_t size;
+
+        /**
+         * @brief Handler of the transfer completion, or a null pointer.
+         *
+         * @note The handler is called in the DMA interrupt context.
+         */
+        api::Runnable* handler;
+
+        /**
+         * @brief Next queued transfer.
+         */
+        Transfer* next;
+    };
+
+    /**
+     * @struct Statistics
+     * @brief Statistics counters, which wrap at 2^32.
+     */
+    struct Statistics
+    {
+        /**
+         * @brief Constructor of zero counters.
+         */
+        Statistics();
+
+        /**
+         * @brief Number of bytes put to the RX ring buffer.
+         */
+        uint32_t rxBytes;
+
+        /**
+         * @brief Number of transmitted bytes.
+         */
+        uint32_t txBytes;
+
+        /**
+         * @brief Number of received bytes lost as the RX ring buffer was full or overrun by DMA.
+         */
+        uint32_t rxDropped;
+
+        /**
+         * @brief Number of overrun errors.
+         */
+        uint32_t overrun;
+
+        /**
+         * @brief Number of framing errors.
+         */
+        uint32_t framing;
+
+        /**
+         * @brief Number of noise errors.
+         */
+        uint32_t noise;
+
+        /**
+         * @brief Number of parity errors.
+         */
+        uint32_t parity;
+
+        /**
+         * @brief Maximum number of bytes in the RX ring buffer.
+         */
+        uint32_t rxHighWater;
+
+        /**
+         * @brief Maximum CPU clock cycles of the USART interrupt handler.
+         */
+        uint32_t isrCycles;
+    };
+
+    /**
+     * @struct Data
+     * @brief Global data for all these objects;
+     */
+    struct Data
+    {
+        /**
+         * @brief Constructor.
+         *
+         * @param reg  Target CPU register model.
+         * @param gie  Global interrupt enable controller.
+         * @param ic   Interrupt controller.
+         * @param gpio General-purpose input output pins.
+         * @param dma  Direct memory access channels.
+         * @param pll  PLL controller.
+         */
+        Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, Dma& adma, PllController& apll);
+
+        /**
+         * @brief Target CPU register model.
+         */
+        Registers& reg;
+
+        /**
+         * @brief Global interrupt enable controller.
+         */
+        api::Guard& gie;
+
+        /**
+         * @brief Interrupt controller.
+         */
+        api::CpuInterruptController& ic;
+
+        /**
+         * @brief General-purpose input output pins.
+         */
+        Gpio& gpio;
+
+        /**
+         * @brief Direct memory access channels.
+         */
+        Dma& dma;
+
+        /**
+         * @brief PLL controller.
+         */
+        PllController& pll;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param data   Global data for all theses objects.
+     * @param index  USART index as Registers::INDEX_USARTx is.
+     * @param config Configuration.
+     */
+    Usart(Data& data, int32_t index, const Config& config);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~Usart();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Handles the USART interrupt.
+     */
+    virtual void start();
+
+    /**
+     * @brief Reads received bytes.
+     *
+     * @param data A buffer to read to.
+     * @param size Maximum number of bytes to read.
+     * @return Number of read bytes.
+     */
+    size_t read(void* data, size_t size);
+
+    /**
+     * @brief Writes bytes to transmit.
+     *
+     * @param data A buffer to write from.
+     * @param size Number of bytes to write.
+     * @return Number of written bytes, which is zero if TX DMA is configured.
+     */
+    size_t write(const void* data, size_t size);
+
+    /**
+     * @brief Queues a caller owned buffer to transmit by DMA.
+     *
+     * @param transfer A transfer descriptor.
+     * @return True if the transfer is queued.
+     */
+    bool_t send(Transfer& transfer);
+
+    /**
+     * @brief Puts the receiver to mute mode until a wake-up condition.
+     *
+     * @note For idle line wake-up, at least one byte has to be received before the receiver is muted.
+     *
+     * @return True if the receiver is muted.
+     */
+    bool_t mute();
+
+    /**
+     * @brief Tests if the receiver is in mute mode.
+     *
+     * @return True if it is muted.
+     */
+    bool_t isMuted() const;
+
+    /**
+     * @brief Returns number of bytes which can be read.
+     *
+     * @return Number of bytes.
+     */
+    size_t getReadable() const;
+
+    /**
+     * @brief Returns number of bytes which can be written.
+     *
+     * @return Number of bytes.
+     */
+    size_t getWritable() const;
+
+    /**
+     * @brief Returns statistics counters.
+     *
+     * @note With RX DMA, errors are counted only if their flags are set on IDLE line.
+     *
+     * @param statistics Statistics counters.
+     */
+    void getStatistics(Statistics& statistics) const;
+
+    /**
+     * @brief Returns the achieved baud rate.
+     *
+     * @return The baud rate, which error is zero if a raw BRR value is configured.
+     */
+    const UsartBaud::Result& getBaud() const;
+
+    /**
+     * @brief Returns the USART index.
+     *
+     * @return The index.
+     */
+    int32_t getIndex() const;
+
+    /**
+     * @brief Tests if an USART index is valid.
+     *
+     * @param index An USART index.
+     * @return True if it is valid.
+     */
+    static bool_t isIndex(int32_t index);
+
+protected:
+
+    using Parent::setConstructed;
+
+private:
+
+    /**
+     * @class Handler
+     * @brief Interrupt handler which calls a function of the resource.
+     */
+    class Handler : public api::Runnable
+    {
+
+    public:
+
+        /**
+         * @brief A function of the resource.
+         */
+        typedef void (Usart::*Function)();
+
+        /**
+         * @brief Constructor.
+         *
+         * @param usart    The resource.
+         * @param function A function to call.
+         */
+        Handler(Usart& usart, Function function);
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~Handler();
+
+        /**
+         * @copydoc eoos::api::Object::isConstructed()
+         */
+        virtual bool_t isConstructed() const;
+
+        /**
+         * @copydoc eoos::api::Runnable::start()
+         */
+        virtual void start();
+
+    private:
+
+        /**
+         * @brief The resource.
+         */
+        Usart& usart_;
+
+        /**
+         * @brief A function to call.
+         */
+        Function function_;
+    };
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the hardware.
+     *
+     * @return True if initialized.
+     */
+    bool_t initialize();
+
+    /**
+     * @brief Deinitializes the hardware.
+     */
+    void deinitialize();
+
+    /**
+     * @brief Calculates BRR value from the USART bus clock.
+     *
+     * @return True if the baud rate is achievable.
+     */
+    bool_t initializeBaud();
+
+    /**
+     * @brief Creates an interrupt resource.
+     *
+     * @param handler   An interrupt handler.
+     * @param exception An exception number.
+     * @return The interrupt resource, or a null pointer if an error has been occurred.
+     */
+    api::CpuInterrupt* createInterrupt(api::Runnable& handler, int32_t exception);
+
+    /**
+     * @brief Initializes RX DMA.
+     *
+     * @return True if initialized, or if the USART has no RX DMA request.
+     */
+    bool_t initializeRxDma();
+
+    /**
+     * @brief Deinitializes RX DMA.
+     */
+    void deinitializeRxDma();
+
+    /**
+     * @brief Handles RX DMA interrupt.
+     */
+    void handleRxDma();
+
+    /**
+     * @brief Moves the RX ring buffer head to RX DMA position.
+     */
+    void updateRxDma();
+
+    /**
+     * @brief Initializes TX DMA.
+     *
+     * @return True if initialized.
+     */
+    bool_t initializeTxDma();
+
+    /**
+     * @brief Deinitializes TX DMA.
+     */
+    void deinitializeTxDma();
+
+    /**
+     * @brief Handles TX DMA interrupt.
+     */
+    void handleTxDma();
+
+    /**
+     * @brief Starts TX DMA to transmit a transfer.
+     *
+     * @param transfer A transfer.
+     */
+    void startTxDma(const Transfer& transfer);
+
+    /**
+     * @brief Clears IDLE flag by reading DR after SR has been read.
+     */
+    void clearIdle();
+
+    /**
+     * @brief Counts receive errors.
+     *
+     * @param sr Status register value.
+     */
+    void countErrors(const reg::Usart::Sr& sr);
+
+    /**
+     * @brief Updates the RX ring buffer high-water mark.
+     */
+    void updateRxHighWater();
+
+    /**
+     * @brief Sets the RS-485 driver enable pin if it is configured.
+     */
+    void enableDriver();
+
+    /**
+     * @brief Tests if no bytes are queued to transmit.
+     *
+     * @return True if the transmitter has nothing to transmit.
+     */
+    bool_t isTxEmpty() const;
+
+    /**
+     * @brief Enables or disables the USART clock.
+     *
+     * @param enable True to enable.
+     */
+    void enableClock(bool_t enable);
+
+    /**
+     * @brief Sets the USART pins to their alternate functions.
+     *
+     * @return True if the pins are set.
+     */
+    bool_t initializePins();
+
+    /**
+     * @brief Returns the USART exception number.
+     *
+     * @return The exception number.
+     */
+    int32_t getException() const;
+
+    /**
+     * @brief Returns the USART TX pin.
+     *
+     * @return The pin.
+     */
+    Gpio::Pin getPinTx() const;
+
+    /**
+     * @brief Returns the USART RX pin.
+     *
+     * @return The pin.
+     */
+    Gpio::Pin getPinRx() const;
+
+    /**
+     * @brief Returns the USART CTS pin.
+     *
+     * @return The pin, which is invalid if the USART has no CTS.
+     */
+    Gpio::Pin getPinCts() const;
+
+    /**
+     * @brief Returns the USART RTS pin.
+     *
+     * @return The pin, which is invalid if the USART has no RTS.
+     */
+    Gpio::Pin getPinRts() const;
+
+    /**
+     * @brief Returns the USART RX DMA channel.
+     *
+     * @return The channel.
+     */
+    Dma::Channel getDmaRx() const;
+
+    /**
+     * @brief Returns the USART TX DMA channel.
+     *
+     * @return The channel.
+     */
+    Dma::Channel getDmaTx() const;
+
+    /**
+     * @brief Number of USARTs.
+     */
+    static const int32_t NUMBER_OF_USARTS = 5;
+
+    /**
+     * @brief Global data for all these objects;
+     */
+    Data& data_;
+
+    /**
+     * @brief USART index.
+     */
+    int32_t index_;
+
+    /**
+     * @brief Configuration.
+     */
+    Config config_;
+
+    /**
+     * @brief USART registers.
+     */
+    reg::Usart* usart_;
+
+    /**
+     * @brief Achieved baud rate.
+     */
+    UsartBaud::Result baud_;
+
+    /**
+     * @brief Received bytes, which the ISR produces.
+     */
+    RingBuffer<uint8_t> rx_;
+
+    /**
+     * @brief Bytes to transmit, which the ISR consumes.
+     */
+    RingBuffer<uint8_t> tx_;
+
+    /**
+     * @brief USART interrupt resource.
+     */
+    api::CpuInterrupt* int_;
+
+    /**
+     * @brief RX DMA channel registers.
+     */
+    reg::Dma::Channel* rxDma_;
+
+    /**
+     * @brief RX DMA interrupt handler.
+     */
+    Handler rxDmaHandler_;
+
+    /**
+     * @brief RX DMA interrupt resource.
+     */
+    api::CpuInterrupt* rxDmaInt_;
+
+    /**
+     * @brief TX DMA channel registers.
+     */
+    reg::Dma::Channel* txDma_;
+
+    /**
+     * @brief TX DMA interrupt handler.
+     */
+    Handler txDmaHandler_;
+
+    /**
+     * @brief TX DMA interrupt resource.
+     */
+    api::CpuInterrupt* txDmaInt_;
+
+    /**
+     * @brief Statistics counters, which are not got from the ring buffers.
+     */
+    Statistics volatile statistics_;
+
+    /**
+     * @brief First queued transfer, which TX DMA transmits.
+     */
+    Transfer* txHead_;
+
+    /**
+     * @brief Last queued transfer.
+     */
+    Transfer* txTail_;
+
+};
+
+template <class A>
+Usart<A>::Usart(Data& data, int32_t index, const Config& config)
+    : NonCopyable<A>()
+    , api::Runnable()
+    , data_( data )
+    , index_( index )
+    , config_( config )
+    , usart_( isIndex(index) ? data.reg.usart[index] : NULLPTR )
+    , baud_()
+    , rx_( config.rxBuffer, config.rxSize )
+    , tx_( config.txBuffer, config.txSize )
+    , int_( NULLPTR )
+    , rxDma_( NULLPTR )
+    , rxDmaHandler_( *this, &Usart::handleRxDma )
+    , rxDmaInt_( NULLPTR )
+    , txDma_( NULLPTR )
+    , txDmaHandler_( *this, &Usart::handleTxDma )
+    , txDmaInt_( NULLPTR )
+    , statistics_()
+    , txHead_( NULLPTR )
+    , txTail_( NULLPTR ) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+template <class A>
+Usart<A>::~Usart()
+{
+    deinitialize();
+}
+
+template <class A>
+bool_t Usart<A>::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+template <class A>
+void Usart<A>::start()
+{
+    uint32_t const begin( data_.reg.dwt->cyccnt.value );
+    reg::Usart::Sr const sr( usart_->sr.value );
+    if( rxDma_ != NULLPTR )
+    {
+        // DMA reads DR on RXNE, thus DR is read here only to clear IDLE
+        if( sr.bit.idle == 1 )
+        {
+            countErrors(sr);
+            clearIdle();
+            updateRxDma();
+        }
+    }
+    else if( config_.flowControl && sr.bit.rxne == 1 && rx_.getFree() == 0U )
+    {
+        // Keep the byte in DR, thus RTS is deasserted until read() frees the RX ring buffer
+        BitBand::clear(usart_->cr1, reg::Usart::Cr1::RXNEIE_BIT);
+    }
+    else if( sr.bit.rxne == 1 || sr.bit.ore == 1 )
+    {
+        // Reading DR after SR clears RXNE, IDLE and the ORE, NE, FE and PE error flags
+        uint8_t const byte( static_cast<uint8_t>(usart_->dr.value) );
+        countErrors(sr);
+        if( rx_.push(byte) )
+        {
+            updateRxHighWater();
+        }
+        else
+        {
+            statistics_.rxDropped++;
+        }
+    }
+    else if( sr.bit.idle == 1 )
+    {
+        clearIdle();
+    }
+    else
+    {
+    }
+    if( sr.bit.idle == 1 && config_.rxHandler != NULLPTR )
+    {
+        config_.rxHandler->start();
+    }
+    if( sr.bit.txe == 1 && usart_->cr1.bit.txeie == 1 )
+    {
+        uint8_t byte( 0 );
+        if( tx_.pop(byte) )
+        {
+            usart_->dr.value = byte;
+        }
+        else
+        {
+            BitBand::clear(usart_->cr1, reg::Usart::Cr1::TXEIE_BIT);
+            if( config_.de.isPin() )
+            {
+                BitBand::set(usart_->cr1, reg::Usart::Cr1::TCIE_BIT);
+            }
+        }
+    }
+    if( sr.bit.tc == 1 && usart_->cr1.bit.tcie == 1 )
+    {
+        BitBand::clear(usart_->cr1, reg::Usart::Cr1::TCIE_BIT);
+        // Bytes written after the last byte has been shifted out keep the driver enabled
+        if( isTxEmpty() )
+        {
+            data_.gpio.reset(config_.de);
+        }
+    }
+    uint32_t const cycles( data_.reg.dwt->cyccnt.value - begin );
+    if( cycles > statistics_.isrCycles )
+    {
+        statistics_.isrCycles = cycles;
+    }
+}
+
+template <class A>
+size_t Usart<A>::read(void* data, size_t size)
+{
+    if( !isConstructed() || data == NULLPTR )
+    {
+        return 0;
+    }
+    if( rxDma_ != NULLPTR )
+    {
+        // DMA has lapped unread bytes, thus they are dropped as some of them are overwritten
+        statistics_.rxDropped += static_cast<uint32_t>( rx_.dropOverrun() );
+    }
+    size_t const count( rx_.read(reinterpret_cast<uint8_t*>(data), size) );
+    if( count != 0U && config_.flowControl && rxDma_ == NULLPTR )
+    {
+        // The ISR clears RXNEIE only if the RX ring buffer is full, so setting it after
+        // the bytes are read lets it receive a byte kept in DR
+        BitBand::set(usart_->cr1, reg::Usart::Cr1::RXNEIE_BIT);
+    }
+    return count;
+}
+
+template <class A>
+size_t Usart<A>::write(const void* data, size_t size)
+{
+    if( !isConstructed() || data == NULLPTR || txDma_ != NULLPTR )
+    {
+        return 0;
+    }
+    size_t const count( tx_.write(reinterpret_cast<const uint8_t*>(data), size) );
+    if( count != 0U )
+    {
+        // The ISR releases the driver only if the TX ring buffer is empty, so enabling it
+        // after the bytes are put does not let the ISR release it before they are transmitted
+        enableDriver();
+        // The ISR clears TXEIE only if the TX ring buffer is empty, so setting it after
+        // the bytes are put does not lose them even if the ISR preempts this function
+        BitBand::set(usart_->cr1, reg::Usart::Cr1::TXEIE_BIT);
+    }
+    return count;
+}
+
+template <class A>
+bool_t Usart<A>::send(Transfer& transfer)
+{
+    if( !isConstructed() || txDma_ == NULLPTR )
+    {
+        return false;
+    }
+    // The DMA number of data register is 16 bits
+    if( transfer.data == NULLPTR || transfer.size == 0U || transfer.size > 0x0000FFFFU )
+    {
+        return false;
+    }
+    transfer.next = NULLPTR;
+    lib::Guard<A> const guard(data_.gie);
+    if( txTail_ == NULLPTR )
+    {
+        txHead_ = &transfer;
+        txTail_ = &transfer;
+        startTxDma(transfer);
+    }
+    else
+    {
+        txTail_->next = &transfer;
+        txTail_ = &transfer;
+    }
+    return true;
+}
+
+template <class A>
+bool_t Usart<A>::mute()
+{
+    if( !isConstructed() || config_.wake == WAKE_NONE )
+    {
+        return false;
+    }
+    BitBand::set(usart_->cr1, reg::Usart::Cr1::RWU_BIT);
+    return true;
+}
+
+template <class A>
+bool_t Usart<A>::isMuted() const
+{
+    if( !isConstructed() )
+    {
+        return false;
+    }
+    return usart_->cr1.bit.rwu == 1;
+}
+
+template <class A>
+size_t Usart<A>::getReadable() const
+{
+    return rx_.getLength();
+}
+
+template <class A>
+size_t Usart<A>::getWritable() const
+{
+    return tx_.getFree();
+}
+
+template <class A>
+void Usart<A>::getStatistics(Statistics& statistics) const
+{
+    // Each counter is read by one load, and the ring buffer indexes count bytes which pass them
+    statistics.rxBytes = rx_.getPushed();
+    statistics.txBytes = ( txDma_ != NULLPTR ) ? statistics_.txBytes : tx_.getPopped();
+    statistics.rxDropped = statistics_.rxDropped;
+    statistics.overrun = statistics_.overrun;
+    statistics.framing = statistics_.framing;
+    statistics.noise = statistics_.noise;
+    statistics.parity = statistics_.parity;
+    statistics.rxHighWater = statistics_.rxHighWater;
+    statistics.isrCycles = statistics_.isrCycles;
+}
+
+template <class A>
+const UsartBaud::Result& Usart<A>::getBaud() const
+{
+    return baud_;
+}
+
+template <class A>
+int32_t Usart<A>::getIndex() const
+{
+    return index_;
+}
+
+template <class A>
+bool_t Usart<A>::isIndex(int32_t index)
+{
+    return 0 <= index && index < NUMBER_OF_USARTS;
+}
+
+template <class A>
+bool_t Usart<A>::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( usart_ == NULLPTR )
+        {
+            break;
+        }
+        if( config_.address > 0x0FU )
+        {
+            break;
+        }
+        if( config_.flowControl && !getPinCts().isPin() )
+        {
+            break;
+        }
+        if( !rx_.isConstructed() )
+        {
+            break;
+        }
+        // The TX ring buffer is not used if TX DMA transmits caller owned buffers
+        if( !config_.txDma && !tx_.isConstructed() )
+        {
+            break;
+        }
+        if( !initialize() )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+template <class A>
+bool_t Usart<A>::initialize()
+{
+    // Occupy the USART by its interrupt handler, as the handler can be set only once
+    int_ = createInterrupt(*this, getException());
+    if( int_ == NULLPTR )
+    {
+        return false;
+    }
+    if( !initializeBaud() )
+    {
+        return false;
+    }
+    if( !initializePins() )
+    {
+        return false;
+    }
+    if( config_.rxDma && !initializeRxDma() )
+    {
+        return false;
+    }
+    if( config_.txDma && !initializeTxDma() )
+    {
+        return false;
+    }
+    {
+        lib::Guard<A> const guard(data_.gie);
+        enableClock(true);
+        usart_->cr1.value = 0;
+        usart_->brr.value = baud_.brr;
+        reg::Usart::Cr2 cr2(0);
+        cr2.bit.stop = static_cast<reg::Usart::Cr2::Value>(config_.stopBits);
+        cr2.bit.add = config_.address;
+        usart_->cr2.value = cr2.value;
+        reg::Usart::Cr3 cr3(0);
+        cr3.bit.dmar = ( rxDma_ != NULLPTR ) ? 1 : 0;
+        cr3.bit.dmat = ( txDma_ != NULLPTR ) ? 1 : 0;
+        cr3.bit.rtse = config_.flowControl ? 1 : 0;
+        cr3.bit.ctse = config_.flowControl ? 1 : 0;
+        usart_->cr3.value = cr3.value;
+        reg::Usart::Cr1 cr1(0);
+        if( config_.parity != PARITY_NONE )
+        {
+            // The parity bit is the MSB of a word, thus 9 bits word keeps 8 data bits
+            cr1.bit.m = 1;
+            cr1.bit.pce = 1;
+            cr1.bit.ps = ( config_.parity == PARITY_ODD ) ? 1 : 0;
+        }
+        cr1.bit.re = 1;
+        cr1.bit.te = 1;
+        cr1.bit.rxneie = ( rxDma_ == NULLPTR ) ? 1 : 0;
+        cr1.bit.idleie = ( rxDma_ != NULLPTR || config_.rxHandler != NULLPTR ) ? 1 : 0;
+        cr1.bit.wake = ( config_.wake == WAKE_ADDRESS_MARK ) ? 1 : 0;
+        cr1.bit.ue = 1;
+        usart_->cr1.value = cr1.value;
+        if( config_.wake == WAKE_ADDRESS_MARK )
+        {
+            // Mute the receiver until a word addressed to this node
+            BitBand::set(usart_->cr1, reg::Usart::Cr1::RWU_BIT);
+        }
+    }
+    if( rxDmaInt_ != NULLPTR )
+    {
+        rxDmaInt_->enable();
+    }
+    if( txDmaInt_ != NULLPTR )
+    {
+        txDmaInt_->enable();
+    }
+    int_->enable();
+    return true;
+}
+
+template <class A>
+void Usart<A>::deinitialize()
+{
+    if( int_ != NULLPTR )
+    {
+        int_->disable();
+        {
+            lib::Guard<A> const guard(data_.gie);
+            usart_->cr1.value = 0;
+            usart_->cr3.value = 0;
+            enableClock(false);
+            data_.gpio.reset(config_.de);
+        }
+        deinitializeRxDma();
+        deinitializeTxDma();
+        delete int_;
+        int_ = NULLPTR;
+    }
+}
+
+template <class A>
+bool_t Usart<A>::initializeBaud()
+{
+    // USART1 is clocked by APB2, and others are clocked by APB1
+    int64_t const clock( ( index_ == Registers::INDEX_USART1 ) ? data_.pll.getApb2Clock() : data_.pll.getApb1Clock() );
+    if( config_.brr == 0U )
+    {
+        return UsartBaud::calculate(clock, config_.baud, baud_);
+    }
+    baud_.brr = config_.brr;
+    baud_.baud = UsartBaud::getBaud(clock, config_.brr);
+    baud_.ppm = 0;
+    return baud_.baud != 0;
+}
+
+template <class A>
+api::CpuInterrupt* Usart<A>::createInterrupt(api::Runnable& handler, int32_t exception)
+{
+    api::CpuInterrupt* res( data_.ic.createResource(handler, exception) );
+    if( res != NULLPTR )
+    {
+        if( !res->isConstructed() )
+        {
+            delete res;
+            res = NULLPTR;
+        }
+    }
+    return res;
+}
+
+template <class A>
+bool_t Usart<A>::initializeRxDma()
+{
+    Dma::Channel const channel( getDmaRx() );
+    reg::Dma::Channel* const dma( data_.dma.getRegisters(channel) );
+    if( dma == NULLPTR )
+    {
+        // The USART without a DMA request receives bytes on RXNE
+        return true;
+    }
+    // The DMA number of data register is 16 bits
+    if( config_.rxSize > 0x0000FFFFU )
+    {
+        return false;
+    }
+    rxDmaInt_ = createInterrupt(rxDmaHandler_, Dma::getException(channel));
+    if( rxDmaInt_ == NULLPTR )
+    {
+        return false;
+    }
+    if( !data_.dma.enableClock(channel) )
+    {
+        return false;
+    }
+    dma->ccr.value = 0;
+    data_.dma.clearFlags(channel, reg::Dma::Isr::GIF_MASK);
+    dma->cpar.value = reinterpret_cast<uint32_t>(&usart_->dr);
+    dma->cmar.value = reinterpret_cast<uint32_t>(config_.rxBuffer);
+    dma->cndtr.value = static_cast<uint32_t>(config_.rxSize);
+    reg::Dma::Ccr ccr(0);
+    ccr.bit.tcie = 1;
+    ccr.bit.htie = 1;
+    ccr.bit.dir = 0;    // Read from peripheral
+    ccr.bit.circ = 1;
+    ccr.bit.minc = 1;
+    ccr.bit.psize = 0;  // 8 bits
+    ccr.bit.msize = 0;  // 8 bits
+    ccr.bit.pl = 2;     // High priority
+    ccr.bit.en = 1;
+    dma->ccr.value = ccr.value;
+    rxDma_ = dma;
+    return true;
+}
+
+template <class A>
+void Usart<A>::deinitializeRxDma()
+{
+    if( rxDmaInt_ != NULLPTR )
+    {
+        if( rxDma_ != NULLPTR )
+        {
+            rxDma_->ccr.value = 0;
+            rxDma_ = NULLPTR;
+        }
+        delete rxDmaInt_;
+        rxDmaInt_ = NULLPTR;
+    }
+}
+
+template <class A>
+void Usart<A>::handleRxDma()
+{
+    Dma::Channel const channel( getDmaRx() );
+    data_.dma.clearFlags(channel, data_.dma.getFlags(channel));
+    updateRxDma();
+}
+
+template <class A>
+void Usart<A>::updateRxDma()
+{
+    // DMA puts a next byte to the memory index of the buffer size minus the number of data,
+    // and the number of data reloads to the buffer size after the last byte is put
+    rx_.advanceHead( config_.rxSize - rxDma_->cndtr.bit.ndt );
+    updateRxHighWater();
+}
+
+template <class A>
+bool_t Usart<A>::initializeTxDma()
+{
+    Dma::Channel const channel( getDmaTx() );
+    reg::Dma::Channel* const dma( data_.dma.getRegisters(channel) );
+    if( dma == NULLPTR )
+    {
+        return false;
+    }
+    txDmaInt_ = createInterrupt(txDmaHandler_, Dma::getException(channel));
+    if( txDmaInt_ == NULLPTR )
+    {
+        return false;
+    }
+    if( !data_.dma.enableClock(channel) )
+    {
+        return false;
+    }
+    dma->ccr.value = 0;
+    data_.dma.clearFlags(channel, reg::Dma::Isr::GIF_MASK);
+    dma->cpar.value = reinterpret_cast<uint32_t>(&usart_->dr);
+    txDma_ = dma;
+    return true;
+}
+
+template <class A>
+void Usart<A>::deinitializeTxDma()
+{
+    if( txDmaInt_ != NULLPTR )
+    {
+        if( txDma_ != NULLPTR )
+        {
+            txDma_->ccr.value = 0;
+            txDma_ = NULLPTR;
+        }
+        delete txDmaInt_;
+        txDmaInt_ = NULLPTR;
+        txHead_ = NULLPTR;
+        txTail_ = NULLPTR;
+    }
+}
+
+template <class A>
+void Usart<A>::handleTxDma()
+{
+    Dma::Channel const channel( getDmaTx() );
+    uint32_t const flags( data_.dma.getFlags(channel) );
+    data_.dma.clearFlags(channel, flags);
+    Transfer* const transfer( txHead_ );
+    if( (flags & reg::Dma::Isr::TCIF_MASK) == 0U || transfer == NULLPTR )
+    {
+        return;
+    }
+    statistics_.txBytes += static_cast<uint32_t>(transfer->size);
+    txHead_ = transfer->next;
+    if( txHead_ == NULLPTR )
+    {
+        txTail_ = NULLPTR;
+        // DMA completes when the last byte is put to DR, and the USART completes when it is shifted out
+        if( config_.de.isPin() )
+        {
+            BitBand::set(usart_->cr1, reg::Usart::Cr1::TCIE_BIT);
+        }
+    }
+    else
+    {
+        startTxDma(*txHead_);
+    }
+    transfer->next = NULLPTR;
+    if( transfer->handler != NULLPTR )
+    {
+        transfer->handler->start();
+    }
+}
+
+template <class A>
+void Usart<A>::startTxDma(const Transfer& transfer)
+{
+    reg::Dma::Ccr ccr(0);
+    ccr.bit.tcie = 1;
+    ccr.bit.dir = 1;    // Read from memory
+    ccr.bit.minc = 1;
+    ccr.bit.psize = 0;  // 8 bits
+    ccr.bit.msize = 0;  // 8 bits
+    ccr.bit.pl = 1;     // Medium priority
+    // The channel registers can be changed only if the channel is disabled
+    txDma_->ccr.value = ccr.value;
+    txDma_->cmar.value = reinterpret_cast<uint32_t>(transfer.data);
+    txDma_->cndtr.value = static_cast<uint32_t>(transfer.size);
+    enableDriver();
+    // DMA writes to DR do not clear TC, thus it is cleared by writing zero
+    usart_->sr.value = ~reg::Usart::Sr::TC_MASK;
+    ccr.bit.en = 1;
+    txDma_->ccr.value = ccr.value;
+}
+
+template <class A>
+void Usart<A>::clearIdle()
+{
+    static_cast<void>( *reinterpret_cast<volatile uint32_t*>(&usart_->dr) );
+}
+
+template <class A>
+void Usart<A>::countErrors(const reg::Usart::Sr& sr)
+{
+    statistics_.overrun += sr.bit.ore;
+    statistics_.framing += sr.bit.fe;
+    statistics_.noise += sr.bit.ne;
+    statistics_.parity += sr.bit.pe;
+}
+
+template <class A>
+void Usart<A>::updateRxHighWater()
+{
+    // With RX DMA, the USART and RX DMA handlers both update the mark, thus a mark may be lost
+    // if one of them preempts the other between the compare and the store
+    uint32_t const length( static_cast<uint32_t>(rx_.getLength()) );
+    if( length > statistics_.rxHighWater )
+    {
+        statistics_.rxHighWater = length;
+    }
+}
+
+template <class A>
+void Usart<A>::enableDriver()
+{
+    if( config_.de.isPin() )
+    {
+        data_.gpio.set(config_.de);
+    }
+}
+
+template <class A>
+bool_t Usart<A>::isTxEmpty() const
+{
+    if( txDma_ != NULLPTR )
+    {
+        return txHead_ == NULLPTR;
+    }
+    return tx_.getLength() == 0U && usart_->cr1.bit.txeie == 0;
+}
+
+template <class A>
+void Usart<A>::enableClock(bool_t enable)
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1:
+        {
+            data_.reg.rcc->apb2enr.bit.usart1en = enable ? 1 : 0;
+            break;
+        }
+        default:
+        {
+            // USART2EN is bit 17 of APB1ENR and USART3EN, UART4EN and UART5EN follow it
+            reg::Rcc::Apb1enr::Value const apb1enr( 0x00020000U << (index_ - Registers::INDEX_USART2) );
+            if( enable )
+            {
+                data_.reg.rcc->apb1enr.value |= apb1enr;
+            }
+            else
+            {
+                data_.reg.rcc->apb1enr.value &= ~apb1enr;
+            }
+            break;
+        }
+    }
+}
+
+template <class A>
+bool_t Usart<A>::initializePins()
+{
+    if( !data_.gpio.setMode(getPinTx(), Gpio::MODE_ALTERNATE_PUSH_PULL) )
+    {
+        return false;
+    }
+    if( !data_.gpio.setMode(getPinRx(), Gpio::MODE_INPUT_FLOATING) )
+    {
+        return false;
+    }
+    if( config_.flowControl )
+    {
+        if( !data_.gpio.setMode(getPinRts(), Gpio::MODE_ALTERNATE_PUSH_PULL) )
+        {
+            return false;
+        }
+        if( !data_.gpio.setMode(getPinCts(), Gpio::MODE_INPUT_FLOATING) )
+        {
+            return false;
+        }
+    }
+    if( config_.de.isPin() )
+    {
+        // The driver is disabled until a first byte is transmitted
+        if( !data_.gpio.setMode(config_.de, Gpio::MODE_OUTPUT_PUSH_PULL) )
+        {
+            return false;
+        }
+        data_.gpio.reset(config_.de);
+    }
+    return true;
+}
+
+template <class A>
+int32_t Usart<A>::getException() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Interrupt<A>::EXCEPTION_USART1;
+        case Registers::INDEX_USART2: return Interrupt<A>::EXCEPTION_USART2;
+        case Registers::INDEX_USART3: return Interrupt<A>::EXCEPTION_USART3;
+        case Registers::INDEX_UART4:  return Interrupt<A>::EXCEPTION_UART4;
+        default:                      return Interrupt<A>::EXCEPTION_UART5;
+    }
+}
+
+template <class A>
+Gpio::Pin Usart<A>::getPinTx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 9);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 2);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 10);
+        case Registers::INDEX_UART4:  return Gpio::Pin(Registers::INDEX_GPIOC, 10);
+        default:                      return Gpio::Pin(Registers::INDEX_GPIOC, 12);
+    }
+}
+
+template <class A>
+Gpio::Pin Usart<A>::getPinRx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 10);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 3);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 11);
+        case Registers::INDEX_UART4:  return Gpio::Pin(Registers::INDEX_GPIOC, 11);
+        default:                      return Gpio::Pin(Registers::INDEX_GPIOD, 2);
+    }
+}
+
+template <class A>
+Gpio::Pin Usart<A>::getPinCts() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 11);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 0);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 13);
+        default:                      return Gpio::Pin();
+    }
+}
+
+template <class A>
+Gpio::Pin Usart<A>::getPinRts() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Gpio::Pin(Registers::INDEX_GPIOA, 12);
+        case Registers::INDEX_USART2: return Gpio::Pin(Registers::INDEX_GPIOA, 1);
+        case Registers::INDEX_USART3: return Gpio::Pin(Registers::INDEX_GPIOB, 14);
+        default:                      return Gpio::Pin();
+    }
+}
+
+template <class A>
+Dma::Channel Usart<A>::getDmaRx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Dma::Channel(Registers::INDEX_DMA1, 5);
+        case Registers::INDEX_USART2: return Dma::Channel(Registers::INDEX_DMA1, 6);
+        case Registers::INDEX_USART3: return Dma::Channel(Registers::INDEX_DMA1, 3);
+        case Registers::INDEX_UART4:  return Dma::Channel(Registers::INDEX_DMA2, 3);
+        default:                      return Dma::Channel();
+    }
+}
+
+template <class A>
+Dma::Channel Usart<A>::getDmaTx() const
+{
+    switch(index_)
+    {
+        case Registers::INDEX_USART1: return Dma::Channel(Registers::INDEX_DMA1, 4);
+        case Registers::INDEX_USART2: return Dma::Channel(Registers::INDEX_DMA1, 7);
+        case Registers::INDEX_USART3: return Dma::Channel(Registers::INDEX_DMA1, 2);
+        case Registers::INDEX_UART4:  return Dma::Channel(Registers::INDEX_DMA2, 5);
+        default:                      return Dma::Channel();
+    }
+}
+
+template <class A>
+Usart<A>::Config::Config()
+    : baud(115200)
+    , brr(0)
+    , parity(PARITY_NONE)
+    , stopBits(STOP_BITS_1)
+    , rxBuffer(NULLPTR)
+    , rxSize(0)
+    , rxDma(false)
+    , rxHandler(NULLPTR)
+    , txDma(false)
+    , txBuffer(NULLPTR)
+    , txSize(0)
+    , de()
+    , wake(WAKE_NONE)
+    , address(0)
+    , flowControl(false) {
+}
+
+template <class A>
+Usart<A>::Statistics::Statistics()
+    : rxBytes(0)
+    , txBytes(0)
+    , rxDropped(0)
+    , overrun(0)
+    , framing(0)
+    , noise(0)
+    , parity(0)
+    , rxHighWater(0)
+    , isrCycles(0) {
+}
+
+template <class A>
+Usart<A>::Transfer::Transfer()
+    : data(NULLPTR)
+    , size(0)
+    , handler(NULLPTR)
+    , next(NULLPTR) {
+}
+
+template <class A>
+Usart<A>::Data::Data(Registers& areg, api::Guard& agie, api::CpuInterruptController& aic, Gpio& agpio, Dma& adma, PllController& apll)
+    : reg(areg)
+    , gie(agie)
+    , ic(aic)
+    , gpio(agpio)
+    , dma(adma)
+    , pll(apll) {
+}
+
+template <class A>
+Usart<A>::Handler::Handler(Usart& usart, Function function)
+    : api::Runnable()
+    , usart_( usart )
+    , function_( function ) {
+}
+
+template <class A>
+Usart<A>::Handler::~Handler()
+{
+}
+
+template <class A>
+bool_t Usart<A>::Handler::isConstructed() const
+{
+    return true;
+}
+
+template <class A>
+void Usart<A>::Handler::start()
+{
+    (usart_.*function_)();
+}
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_USART_HPP_
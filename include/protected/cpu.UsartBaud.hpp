@@ -0,0 +1,91 @@
+/**
+ * @file      cpu.UsartBaud.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_USARTBAUD_HPP_
+#define CPU_USARTBAUD_HPP_
+
+#include "cpu.Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class UsartBaud
+ * @brief USART baud rate divisor calculator.
+ *
+ * The USART baud rate is PCLK / (16 * USARTDIV), where USARTDIV is a fixed point
+ * value of BRR with 12 bits mantissa and 4 bits fraction, thus BRR equals rounded
+ * PCLK / baud rate.
+ */
+class UsartBaud
+{
+
+public:
+
+    /**
+     * @struct Result
+     * @brief Calculated baud rate.
+     */
+    struct Result
+    {
+        /**
+         * @brief Constructor.
+         */
+        Result();
+
+        /**
+         * @brief BRR value.
+         */
+        uint32_t brr;
+
+        /**
+         * @brief Achieved baud rate.
+         */
+        int64_t baud;
+
+        /**
+         * @brief Error of the achieved baud rate in parts per million.
+         */
+        int32_t ppm;
+    };
+
+    /**
+     * @brief Calculates BRR value.
+     *
+     * @param clock  A PCLK of the USART in Hz.
+     * @param baud   A baud rate to achieve.
+     * @param result A calculated result.
+     * @return True if the baud rate is achievable.
+     */
+    static bool_t calculate(int64_t clock, int64_t baud, Result& result);
+
+    /**
+     * @brief Calculates the baud rate of BRR value.
+     *
+     * @param clock  A PCLK of the USART in Hz.
+     * @param brr    A BRR value.
+     * @return The baud rate, or zero if BRR value is wrong.
+     */
+    static int64_t getBaud(int64_t clock, uint32_t brr);
+
+private:
+
+    /**
+     * @brief Minimal BRR value of USARTDIV equal to 1.
+     */
+    static const uint32_t BRR_MIN = 0x00000010;
+
+    /**
+     * @brief Maximal BRR value.
+     */
+    static const uint32_t BRR_MAX = 0x0000FFFF;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_USARTBAUD_HPP_
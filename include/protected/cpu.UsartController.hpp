@@ -0,0 +1,135 @@
+/**
+ * @file      cpu.UsartController.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_USARTCONTROLLER_HPP_
+#define CPU_USARTCONTROLLER_HPP_
+
+#include "cpu.NonCopyable.hpp"
+#include "api.CpuInterruptController.hpp"
+#include "cpu.Usart.hpp"
+#include "cpu.Gpio.hpp"
+#include "cpu.Dma.hpp"
+#include "cpu.PllController.hpp"
+#include "cpu.Registers.hpp"
+#include "lib.ResourceMemory.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @class UsartController
+ * @brief CPU HW USART controller.
+ */
+class UsartController : public NonCopyable<NoAllocator>
+{
+    typedef NonCopyable<NoAllocator> Parent;
+
+public:
+
+    /**
+     * @brief USART resource.
+     */
+    typedef Usart<UsartController> Resource;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param reg  Target CPU register model.
+     * @param gie  Global interrupt enable controller.
+     * @param ic   Interrupt controller.
+     * @param gpio General-purpose input output pins.
+     * @param dma  Direct memory access channels.
+     * @param pll  PLL controller.
+     */
+    UsartController(Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, Gpio& gpio, Dma& dma, PllController& pll);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~UsartController();
+
+    /**
+     * @copydoc eoos::api::Object::isConstructed()
+     */
+    virtual bool_t isConstructed() const;
+
+    /**
+     * @brief Creates a new USART resource.
+     *
+     * @param index  USART index as Registers::INDEX_USARTx is.
+     * @param config Configuration.
+     * @return A new USART resource, or NULLPTR if an error has been occurred.
+     */
+    Resource* createResource(int32_t index, const Resource::Config& config);
+
+    /**
+     * @brief Allocates memory.
+     *
+     * @param size Number of bytes to allocate.
+     * @return Allocated memory address or a null pointer.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * @brief Frees allocated memory.
+     *
+     * @param ptr Address of allocated memory block or a null pointer.
+     */
+    static void free(void* ptr);
+
+private:
+
+    /**
+     * @brief Constructs this object.
+     *
+     * @return true if object has been constructed successfully.
+     */
+    bool_t construct();
+
+    /**
+     * @brief Initializes the allocator with heap for resource allocation.
+     *
+     * @param resource Heap for resource allocation.
+     * @return True if initialized.
+     */
+    static bool_t initialize(api::Heap* resource);
+
+    /**
+     * @brief Deinitializes the allocator.
+     */
+    static void deinitialize();
+
+    /**
+     * @brief Heap for resource allocation.
+     */
+    static api::Heap* resource_;
+
+    /**
+     * @brief Target CPU register model.
+     */
+    Registers& reg_;
+
+    /**
+     * @brief Global interrupt enable controller.
+     */
+    api::Guard& gie_;
+
+    /**
+     * @brief Resource memory allocator.
+     */
+    lib::ResourceMemory<Resource, EOOS_GLOBAL_CPU_NUMBER_OF_USARTS> memory_;
+
+    /**
+     * @brief Global data for all Usart objects;
+     */
+    Resource::Data data_;
+
+};
+
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_USARTCONTROLLER_HPP_
@@ -117,6 +117,9 @@ public:
             Value rx    : 1;
             Value       : 20;
         } bit;
+
+        static const Value ERRI_MASK = 0x00000004;
+        static const Value WKUI_MASK = 0x00000008;
     };
 
     /**
@@ -162,6 +165,9 @@ public:
         static const Value RQCP0_MASK = 0x00000001;        
         static const Value RQCP1_MASK = 0x00000100;
         static const Value RQCP2_MASK = 0x00010000;
+        static const Value ABRQ0_MASK = 0x00000080;
+        static const Value ABRQ1_MASK = 0x00008000;
+        static const Value ABRQ2_MASK = 0x00800000;
     };
 
     /**
@@ -184,6 +190,9 @@ public:
             Value rfomx : 1;
             Value       : 26;
         } bit;
+
+        static const Value FOVR_MASK = 0x00000010;
+        static const Value RFOM_MASK = 0x00000020;
     };
 
     /**
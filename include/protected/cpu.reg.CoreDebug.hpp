@@ -0,0 +1,169 @@
+/**
+ * @file      cpu.reg.CoreDebug.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_COREDEBUG_HPP_
+#define CPU_REG_COREDEBUG_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct CoreDebug
+ * @brief Debug registers of System Control Space.
+ */
+struct CoreDebug
+{
+
+public:
+
+    /**
+     * @brief System Control address.
+     */
+    static const uint32_t ADDRESS = 0xE000EDF0;
+
+    /**
+     * @brief Constructor.
+     */
+    CoreDebug()
+        : dhcsr()
+        , dcrsr()
+        , dcrdr()
+        , demcr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~CoreDebug(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    static void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief Debug Halting Control and Status Register.
+     */
+    union Dhcsr
+    {
+        typedef uint32_t Value;
+        Dhcsr(){}
+        Dhcsr(Value v){value = v;}
+       ~Dhcsr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value cDebugen   : 1;
+            Value cHalt      : 1;
+            Value cStep      : 1;
+            Value cMaskints  : 1;
+            Value            : 1;
+            Value cSnapstall : 1;
+            Value            : 10;
+            Value sRegrdy    : 1;
+            Value sHalt      : 1;
+            Value sSleep     : 1;
+            Value sLockup    : 1;
+            Value            : 4;
+            Value sRetireSt  : 1;
+            Value sResetSt   : 1;
+            Value            : 6;
+        } bit;
+    };
+
+    /**
+     * @brief Debug Core Register Selector Register.
+     */
+    union Dcrsr
+    {
+        typedef uint32_t Value;
+        Dcrsr(){}
+        Dcrsr(Value v){value = v;}
+       ~Dcrsr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value regsel : 5;
+            Value        : 11;
+            Value regwnr : 1;
+            Value        : 15;
+        } bit;
+    };
+
+    /**
+     * @brief Debug Core Register Data Register.
+     */
+    union Dcrdr
+    {
+        typedef uint32_t Value;
+        Dcrdr(){}
+        Dcrdr(Value v){value = v;}
+       ~Dcrdr(){}
+
+        Value value;
+    };
+
+    /**
+     * @brief Debug Exception and Monitor Control Register.
+     */
+    union Demcr
+    {
+        typedef uint32_t Value;
+        Demcr(){}
+        Demcr(Value v){value = v;}
+       ~Demcr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value vcCorereset : 1;
+            Value             : 3;
+            Value vcMmerr     : 1;
+            Value vcNocperr   : 1;
+            Value vcChkerr    : 1;
+            Value vcStaterr   : 1;
+            Value vcBuserr    : 1;
+            Value vcInterr    : 1;
+            Value vcHarderr   : 1;
+            Value             : 5;
+            Value monEn       : 1;
+            Value monPend     : 1;
+            Value monStep     : 1;
+            Value monReq      : 1;
+            Value             : 4;
+            Value trcena      : 1;
+            Value             : 7;
+        } bit;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Dhcsr dhcsr;  // 0xE000EDF0
+    Dcrsr dcrsr;  // 0xE000EDF4
+    Dcrdr dcrdr;  // 0xE000EDF8
+    Demcr demcr;  // 0xE000EDFC
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_COREDEBUG_HPP_
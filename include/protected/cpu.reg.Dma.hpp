@@ -0,0 +1,275 @@
+/**
+ * @file      cpu.reg.Dma.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_DMA_HPP_
+#define CPU_REG_DMA_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Dma
+ * @brief Direct Memory Access controller (DMA).
+ */
+struct Dma
+{
+
+public:
+
+    /**
+     * @brief Addresses.
+     */
+    static const uint32_t ADDRESS_DMA1 = 0x40020000;
+    static const uint32_t ADDRESS_DMA2 = 0x40020400;
+
+    /**
+     * @brief Number of channels.
+     */
+    static const int32_t NUMBER_OF_CHANNELS = 7;
+
+    /**
+     * @brief Constructor.
+     */
+    Dma()
+        : isr()
+        , ifcr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Dma(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief DMA interrupt status register (DMA_ISR).
+     *
+     * @note Each channel has four flags starting from bit 4 * (channel - 1).
+     */
+    union Isr
+    {
+        typedef uint32_t Value;
+        Isr(){}
+        Isr(Value v){value = v;}
+       ~Isr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value gif1  : 1;
+            Value tcif1 : 1;
+            Value htif1 : 1;
+            Value teif1 : 1;
+            Value gif2  : 1;
+            Value tcif2 : 1;
+            Value htif2 : 1;
+            Value teif2 : 1;
+            Value gif3  : 1;
+            Value tcif3 : 1;
+            Value htif3 : 1;
+            Value teif3 : 1;
+            Value gif4  : 1;
+            Value tcif4 : 1;
+            Value htif4 : 1;
+            Value teif4 : 1;
+            Value gif5  : 1;
+            Value tcif5 : 1;
+            Value htif5 : 1;
+            Value teif5 : 1;
+            Value gif6  : 1;
+            Value tcif6 : 1;
+            Value htif6 : 1;
+            Value teif6 : 1;
+            Value gif7  : 1;
+            Value tcif7 : 1;
+            Value htif7 : 1;
+            Value teif7 : 1;
+            Value       : 4;
+        } bit;
+
+        static const Value GIF_MASK  = 0x1;
+        static const Value TCIF_MASK = 0x2;
+        static const Value HTIF_MASK = 0x4;
+        static const Value TEIF_MASK = 0x8;
+    };
+
+    /**
+     * @brief DMA interrupt flag clear register (DMA_IFCR).
+     *
+     * @note Each channel has four flags starting from bit 4 * (channel - 1).
+     */
+    union Ifcr
+    {
+        typedef uint32_t Value;
+        Ifcr(){}
+        Ifcr(Value v){value = v;}
+       ~Ifcr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value cgif1  : 1;
+            Value ctcif1 : 1;
+            Value chtif1 : 1;
+            Value cteif1 : 1;
+            Value cgif2  : 1;
+            Value ctcif2 : 1;
+            Value chtif2 : 1;
+            Value cteif2 : 1;
+            Value cgif3  : 1;
+            Value ctcif3 : 1;
+            Value chtif3 : 1;
+            Value cteif3 : 1;
+            Value cgif4  : 1;
+            Value ctcif4 : 1;
+            Value chtif4 : 1;
+            Value cteif4 : 1;
+            Value cgif5  : 1;
+            Value ctcif5 : 1;
+            Value chtif5 : 1;
+            Value cteif5 : 1;
+            Value cgif6  : 1;
+            Value ctcif6 : 1;
+            Value chtif6 : 1;
+            Value cteif6 : 1;
+            Value cgif7  : 1;
+            Value ctcif7 : 1;
+            Value chtif7 : 1;
+            Value cteif7 : 1;
+            Value        : 4;
+        } bit;
+    };
+
+    /**
+     * @brief DMA channel x configuration register (DMA_CCRx).
+     */
+    union Ccr
+    {
+        typedef uint32_t Value;
+        Ccr(){}
+        Ccr(Value v){value = v;}
+       ~Ccr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value en      : 1;
+            Value tcie    : 1;
+            Value htie    : 1;
+            Value teie    : 1;
+            Value dir     : 1;
+            Value circ    : 1;
+            Value pinc    : 1;
+            Value minc    : 1;
+            Value psize   : 2;
+            Value msize   : 2;
+            Value pl      : 2;
+            Value mem2mem : 1;
+            Value         : 17;
+        } bit;
+    };
+
+    /**
+     * @brief DMA channel x number of data register (DMA_CNDTRx).
+     */
+    union Cndtr
+    {
+        typedef uint32_t Value;
+        Cndtr(){}
+        Cndtr(Value v){value = v;}
+       ~Cndtr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value ndt : 16;
+            Value     : 16;
+        } bit;
+    };
+
+    /**
+     * @brief DMA channel x peripheral address register (DMA_CPARx).
+     */
+    union Cpar
+    {
+        typedef uint32_t Value;
+        Cpar(){}
+        Cpar(Value v){value = v;}
+       ~Cpar(){}
+
+        Value value;
+        struct Bit
+        {
+            Value pa : 32;
+        } bit;
+    };
+
+    /**
+     * @brief DMA channel x memory address register (DMA_CMARx).
+     */
+    union Cmar
+    {
+        typedef uint32_t Value;
+        Cmar(){}
+        Cmar(Value v){value = v;}
+       ~Cmar(){}
+
+        Value value;
+        struct Bit
+        {
+            Value ma : 32;
+        } bit;
+    };
+
+    /**
+     * @struct Channel
+     * @brief DMA channel registers.
+     */
+    struct Channel
+    {
+        Channel()
+            : ccr()
+            , cndtr()
+            , cpar()
+            , cmar() {
+        }
+
+        Ccr      ccr;      // 0x08 + 0x14 * (x - 1)
+        Cndtr    cndtr;    // 0x0C + 0x14 * (x - 1)
+        Cpar     cpar;     // 0x10 + 0x14 * (x - 1)
+        Cmar     cmar;     // 0x14 + 0x14 * (x - 1)
+        uint32_t reserved; // 0x18 + 0x14 * (x - 1)
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Isr     isr;                          // 0x00
+    Ifcr    ifcr;                         // 0x04
+    Channel channel[NUMBER_OF_CHANNELS];  // 0x08 - 0x9B
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_DMA_HPP_
@@ -0,0 +1,129 @@
+/**
+ * @file      cpu.reg.Dwt.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_DWT_HPP_
+#define CPU_REG_DWT_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Dwt
+ * @brief Data Watchpoint and Trace unit.
+ */
+struct Dwt
+{
+
+public:
+
+    /**
+     * @brief Data Watchpoint and Trace unit address.
+     */
+    static const uint32_t ADDRESS = 0xE0001000;
+
+    /**
+     * @brief Constructor.
+     */
+    Dwt()
+        : ctrl()
+        , cyccnt()
+        , cpicnt()
+        , exccnt()
+        , sleepcnt()
+        , lsucnt()
+        , foldcnt()
+        , pcsr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Dwt(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    static void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief Control Register (DWT_CTRL).
+     */
+    union Ctrl
+    {
+        typedef uint32_t Value;
+        Ctrl(){}
+        Ctrl(Value v){value = v;}
+       ~Ctrl(){}
+
+        Value value;
+        struct Bit
+        {
+            Value cyccntena   : 1;
+            Value postpreset  : 4;
+            Value postinit    : 4;
+            Value cyctap      : 1;
+            Value synctap     : 2;
+            Value pcsamplena  : 1;
+            Value             : 3;
+            Value exctrcena   : 1;
+            Value cpievtena   : 1;
+            Value excevtena   : 1;
+            Value sleepevtena : 1;
+            Value lsuevtena   : 1;
+            Value foldevtena  : 1;
+            Value cycevtena   : 1;
+            Value             : 1;
+            Value noprfcnt    : 1;
+            Value nocyccnt    : 1;
+            Value noexttrig   : 1;
+            Value notrcpkt    : 1;
+            Value numcomp     : 4;
+        } bit;
+    };
+
+    /**
+     * @brief Counter Register.
+     */
+    union Cnt
+    {
+        typedef uint32_t Value;
+        Cnt(){}
+        Cnt(Value v){value = v;}
+       ~Cnt(){}
+
+        Value value;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Ctrl ctrl;      // 0xE0001000
+    Cnt  cyccnt;    // 0xE0001004
+    Cnt  cpicnt;    // 0xE0001008
+    Cnt  exccnt;    // 0xE000100C
+    Cnt  sleepcnt;  // 0xE0001010
+    Cnt  lsucnt;    // 0xE0001014
+    Cnt  foldcnt;   // 0xE0001018
+    Cnt  pcsr;      // 0xE000101C
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_DWT_HPP_
@@ -0,0 +1,97 @@
+/**
+ * @file      cpu.reg.Exti.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_EXTI_HPP_
+#define CPU_REG_EXTI_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Exti
+ * @brief External interrupt/event controller.
+ *
+ * Each register has one bit per EXTI line from 0 to 19.
+ */
+struct Exti
+{
+
+public:
+
+    /**
+     * @brief External interrupt/event controller address.
+     */
+    static const uint32_t ADDRESS = 0x40010400;
+
+    /**
+     * @brief Constructor.
+     */
+    Exti()
+        : imr()
+        , emr()
+        , rtsr()
+        , ftsr()
+        , swier()
+        , pr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Exti(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief Line register (EXTI_IMR, EXTI_EMR, EXTI_RTSR, EXTI_FTSR, EXTI_SWIER and EXTI_PR).
+     */
+    union Line
+    {
+        typedef uint32_t Value;
+        Line(){}
+        Line(Value v){value = v;}
+       ~Line(){}
+
+        Value value;
+        struct Bit
+        {
+            Value line : 20;
+            Value      : 12;
+        } bit;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Line imr;   // 0x00
+    Line emr;   // 0x04
+    Line rtsr;  // 0x08
+    Line ftsr;  // 0x0C
+    Line swier; // 0x10
+    Line pr;    // 0x14
+
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_EXTI_HPP_
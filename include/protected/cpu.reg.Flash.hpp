@@ -89,6 +89,8 @@ public:
             Value prftbs  : 1;
             Value         : 26;
         } bit;
+        
+        static const Value PRFTBE_BIT = 4;
     };
   
     /**
@@ -0,0 +1,193 @@
+/**
+ * @file      cpu.reg.Mpu.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_MPU_HPP_
+#define CPU_REG_MPU_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Mpu
+ * @brief Memory Protection Unit of System Control Space.
+ */
+struct Mpu
+{
+
+public:
+
+    /**
+     * @brief System Control address.
+     */
+    static const uint32_t ADDRESS = 0xE000ED90;
+
+    /**
+     * @brief Constructor.
+     */
+    Mpu()
+        : type()
+        , ctrl()
+        , rnr()
+        , rbar()
+        , rasr()
+        , rbarA1()
+        , rasrA1()
+        , rbarA2()
+        , rasrA2()
+        , rbarA3()
+        , rasrA3() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Mpu(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    static void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief MPU Type Register.
+     */
+    union Type
+    {
+        typedef uint32_t Value;
+        Type(){}
+        Type(Value v){value = v;}
+       ~Type(){}
+
+        Value value;
+        struct Bit
+        {
+            Value separate : 1;
+            Value          : 7;
+            Value dregion  : 8;
+            Value iregion  : 8;
+            Value          : 8;
+        } bit;
+    };
+
+    /**
+     * @brief MPU Control Register.
+     */
+    union Ctrl
+    {
+        typedef uint32_t Value;
+        Ctrl(){}
+        Ctrl(Value v){value = v;}
+       ~Ctrl(){}
+
+        Value value;
+        struct Bit
+        {
+            Value enable     : 1;
+            Value hfnmiena   : 1;
+            Value privdefena : 1;
+            Value            : 29;
+        } bit;
+    };
+
+    /**
+     * @brief MPU Region Number Register.
+     */
+    union Rnr
+    {
+        typedef uint32_t Value;
+        Rnr(){}
+        Rnr(Value v){value = v;}
+       ~Rnr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value region : 8;
+            Value        : 24;
+        } bit;
+    };
+
+    /**
+     * @brief MPU Region Base Address Register.
+     */
+    union Rbar
+    {
+        typedef uint32_t Value;
+        Rbar(){}
+        Rbar(Value v){value = v;}
+       ~Rbar(){}
+
+        Value value;
+        struct Bit
+        {
+            Value region : 4;
+            Value valid  : 1;
+            Value addr   : 27;
+        } bit;
+    };
+
+    /**
+     * @brief MPU Region Attribute and Size Register.
+     */
+    union Rasr
+    {
+        typedef uint32_t Value;
+        Rasr(){}
+        Rasr(Value v){value = v;}
+       ~Rasr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value enable : 1;
+            Value size   : 5;
+            Value        : 2;
+            Value srd    : 8;
+            Value b      : 1;
+            Value c      : 1;
+            Value s      : 1;
+            Value tex    : 3;
+            Value        : 2;
+            Value ap     : 3;
+            Value        : 1;
+            Value xn     : 1;
+            Value        : 3;
+        } bit;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Type        type;    // 0xE000ED90
+    Ctrl        ctrl;    // 0xE000ED94
+    Rnr         rnr;     // 0xE000ED98
+    Rbar        rbar;    // 0xE000ED9C
+    Rasr        rasr;    // 0xE000EDA0
+    Rbar        rbarA1;  // 0xE000EDA4
+    Rasr        rasrA1;  // 0xE000EDA8
+    Rbar        rbarA2;  // 0xE000EDAC
+    Rasr        rasrA2;  // 0xE000EDB0
+    Rbar        rbarA3;  // 0xE000EDB4
+    Rasr        rasrA3;  // 0xE000EDB8
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_MPU_HPP_
@@ -0,0 +1,115 @@
+/**
+ * @file      cpu.reg.Pwr.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_PWR_HPP_
+#define CPU_REG_PWR_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Pwr
+ * @brief Power control.
+ */
+struct Pwr
+{
+
+public:
+
+    /**
+     * @brief Power control address.
+     */
+    static const uint32_t ADDRESS = 0x40007000;
+
+    /**
+     * @brief Constructor.
+     */
+    Pwr()
+        : cr()
+        , csr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Pwr(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief Power control register (PWR_CR).
+     */
+    union Cr
+    {
+        typedef uint32_t Value;
+        Cr(){}
+        Cr(Value v){value = v;}
+       ~Cr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value lpds : 1;
+            Value pdds : 1;
+            Value cwuf : 1;
+            Value csbf : 1;
+            Value pvde : 1;
+            Value pls  : 3;
+            Value dbp  : 1;
+            Value      : 23;
+        } bit;
+    };
+
+    /**
+     * @brief Power control/status register (PWR_CSR).
+     */
+    union Csr
+    {
+        typedef uint32_t Value;
+        Csr(){}
+        Csr(Value v){value = v;}
+       ~Csr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value wuf  : 1;
+            Value sbf  : 1;
+            Value pvdo : 1;
+            Value      : 5;
+            Value ewup : 1;
+            Value      : 23;
+        } bit;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Cr  cr;  // 0x00
+    Csr csr; // 0x04
+
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_PWR_HPP_
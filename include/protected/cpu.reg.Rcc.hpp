@@ -100,6 +100,8 @@ public:
             Value pllrdy   : 1;
             Value          : 6;
         } bit;
+        
+        static const Value HSEON_BIT = 16;
     };
     
     /**
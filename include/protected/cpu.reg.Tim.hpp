@@ -0,0 +1,200 @@
+/**
+ * @file      cpu.reg.Tim.hpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#ifndef CPU_REG_TIM_HPP_
+#define CPU_REG_TIM_HPP_
+
+#include "Types.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+namespace reg
+{
+
+/**
+ * @struct Tim
+ * @brief Basic timers (TIM6 and TIM7).
+ */
+struct Tim
+{
+
+public:
+
+    /**
+     * @brief Addresses.
+     */
+    static const uint32_t ADDRESS_TIM6 = 0x40001000;
+    static const uint32_t ADDRESS_TIM7 = 0x40001400;
+
+    /**
+     * @brief Constructor.
+     */
+    Tim()
+        : cr1()
+        , cr2()
+        , dier()
+        , sr()
+        , egr()
+        , cnt()
+        , psc()
+        , arr() {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~Tim(){}
+
+    /**
+     * @brief Operator new.
+     *
+     * @param size Unused.
+     * @param ptr  Address of memory.
+     * @return The address of memory.
+     */
+    void* operator new(size_t, uint32_t ptr)
+    {
+        return reinterpret_cast<void*>(ptr);
+    }
+
+    /**
+     * @brief Control register 1 (TIMx_CR1).
+     */
+    union Cr1
+    {
+        typedef uint32_t Value;
+        Cr1(){}
+        Cr1(Value v){value = v;}
+       ~Cr1(){}
+
+        Value value;
+        struct Bit
+        {
+            Value cen  : 1;
+            Value udis : 1;
+            Value urs  : 1;
+            Value opm  : 1;
+            Value      : 3;
+            Value arpe : 1;
+            Value      : 24;
+        } bit;
+    };
+
+    /**
+     * @brief Control register 2 (TIMx_CR2).
+     */
+    union Cr2
+    {
+        typedef uint32_t Value;
+        Cr2(){}
+        Cr2(Value v){value = v;}
+       ~Cr2(){}
+
+        Value value;
+        struct Bit
+        {
+            Value     : 4;
+            Value mms : 3;
+            Value     : 25;
+        } bit;
+    };
+
+    /**
+     * @brief DMA/Interrupt enable register (TIMx_DIER).
+     */
+    union Dier
+    {
+        typedef uint32_t Value;
+        Dier(){}
+        Dier(Value v){value = v;}
+       ~Dier(){}
+
+        Value value;
+        struct Bit
+        {
+            Value uie : 1;
+            Value     : 7;
+            Value ude : 1;
+            Value     : 23;
+        } bit;
+    };
+
+    /**
+     * @brief Status register (TIMx_SR).
+     */
+    union Sr
+    {
+        typedef uint32_t Value;
+        Sr(){}
+        Sr(Value v){value = v;}
+       ~Sr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value uif : 1;
+            Value     : 31;
+        } bit;
+    };
+
+    /**
+     * @brief Event generation register (TIMx_EGR).
+     */
+    union Egr
+    {
+        typedef uint32_t Value;
+        Egr(){}
+        Egr(Value v){value = v;}
+       ~Egr(){}
+
+        Value value;
+        struct Bit
+        {
+            Value ug : 1;
+            Value    : 31;
+        } bit;
+    };
+
+    /**
+     * @brief Counter (TIMx_CNT), prescaler (TIMx_PSC) and auto-reload register (TIMx_ARR).
+     */
+    union Cnt
+    {
+        typedef uint32_t Value;
+        Cnt(){}
+        Cnt(Value v){value = v;}
+       ~Cnt(){}
+
+        Value value;
+        struct Bit
+        {
+            Value cnt : 16;
+            Value     : 16;
+        } bit;
+    };
+
+    /**
+     * @brief Register map.
+     */
+public:
+    Cr1      cr1;          // 0x00
+    Cr2      cr2;          // 0x04
+    uint32_t reserved0;    // 0x08
+    Dier     dier;         // 0x0C
+    Sr       sr;           // 0x10
+    Egr      egr;          // 0x14
+    uint32_t reserved1[3]; // 0x18
+    Cnt      cnt;          // 0x24
+    Cnt      psc;          // 0x28
+    Cnt      arr;          // 0x2C
+
+};
+
+} // namespace reg
+} // namespace cpu
+} // namespace eoos
+#endif // CPU_REG_TIM_HPP_
@@ -88,6 +88,9 @@ public:
             Value cts  : 1;
             Value      : 22;
         } bit;
+
+        static const Value TC_MASK  = 0x40;
+        static const Value LBD_MASK = 0x100;
     };
 
     /**
@@ -156,6 +159,12 @@ public:
             Value ue     : 1;
             Value        : 18;
         } bit;
+
+        static const Value SBK_BIT    = 0;
+        static const Value RWU_BIT    = 1;
+        static const Value RXNEIE_BIT = 5;
+        static const Value TCIE_BIT   = 6;
+        static const Value TXEIE_BIT  = 7;
     };
 
     /**
@@ -21,6 +21,7 @@
                 .extern     main
                 .extern     CpuBoot_initialize
                 .extern     CpuBoot_fillStack
+                .extern     v_tcb_running
                 
                 .bss
                 .align  8
@@ -139,7 +140,15 @@ v_stack_fill:   .word   0xDAEDDAED
 CpuBoot_startFirstTask:
                 ldr	    r0, =pxCurrentTCB
                 ldr     r0, [r0]
+                ldr     r1, =v_tcb_running
+                str     r0, [r1]
                 ldr     sp, [r0]
+.ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+                ldmia   sp!, {r2, r3}
+                ldr     r1, =0xE000ED9C
+                stmia   r1, {r2, r3}
+                dsb
+.endif
                 ldmia   sp!, {r4-r11}
                 ldr     r1, [sp, #28]
                 msr     XPSR_nzcvq, r1
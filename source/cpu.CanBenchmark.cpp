@@ -0,0 +1,174 @@
+/**
+ * @file      cpu.CanBenchmark.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanBenchmark.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanBenchmark::CanBenchmark(CanController::Resource& can, CycleCounter& cyc, int64_t clock)
+    : NonCopyable<NoAllocator>()
+    , can_(can)
+    , cyc_(cyc)
+    , clock_(clock)
+    , term_()
+    , filter_(term_, 1)
+    , rule_(0U, NUMBER_OF_IDS - 1U, false) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanBenchmark::~CanBenchmark()
+{
+}
+
+bool_t CanBenchmark::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t CanBenchmark::run(uint32_t frames, Result& result)
+{
+    result = Result();
+    if( !isConstructed() || frames == 0U )
+    {
+        return false;
+    }
+    // Release frames left from a previous run
+    while( can_.receive() != NULLPTR )
+    {
+        can_.release();
+    }
+    CanController::Resource::Statistics before;
+    can_.getStatistics(before);
+    CanFrame frame;
+    frame.size = CanFrame::DATA_SIZE;
+    uint32_t const timeout( static_cast<uint32_t>(clock_ / TIMEOUT_DIVIDER) );
+    uint32_t const begin( cyc_.getCycles() );
+    uint32_t progress( begin );
+    uint32_t sent( 0U );
+    uint32_t expected( 0U );
+    uint64_t latency( 0U );
+    while( result.frames + result.errors < frames )
+    {
+        // Keep the TX queue full to transmit frames back-to-back
+        while( sent < frames )
+        {
+            frame.id = sent % NUMBER_OF_IDS;
+            // A frame of a less identifier would overtake frames queued before it
+            if( frame.id == 0U && result.frames != sent )
+            {
+                break;
+            }
+            setWord(&frame.data[0], cyc_.getCycles());
+            setWord(&frame.data[4], sent);
+            if( !can_.transmit(frame) )
+            {
+                break;
+            }
+            sent++;
+        }
+        CanController::Resource::RxFrame const* const rx( can_.receive() );
+        uint32_t const now( cyc_.getCycles() );
+        if( rx == NULLPTR )
+        {
+            if( now - progress > timeout )
+            {
+                // The rest frames are lost
+                result.errors += frames - result.frames - result.errors;
+            }
+            continue;
+        }
+        progress = now;
+        uint32_t const cycles( now - getWord(&rx->frame.data[0]) );
+        uint32_t const sequence( getWord(&rx->frame.data[4]) );
+        can_.release();
+        if( sequence != expected )
+        {
+            result.errors++;
+        }
+        expected = sequence + 1U;
+        result.frames++;
+        latency += cycles;
+        if( cycles > result.latencyMax )
+        {
+            result.latencyMax = cycles;
+        }
+    }
+    result.cycles = cyc_.getCycles() - begin;
+    CanController::Resource::Statistics after;
+    can_.getStatistics(after);
+    if( result.frames != 0U )
+    {
+        result.isrCyclesPerFrame = (after.isrCycles - before.isrCycles) / result.frames;
+        result.latencyAverage = static_cast<uint32_t>(latency / result.frames);
+    }
+    if( result.cycles != 0U )
+    {
+        result.framesPerSecond = static_cast<uint32_t>( static_cast<int64_t>(result.frames) * clock_ / result.cycles );
+    }
+    return result.errors == 0U;
+}
+
+bool_t CanBenchmark::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !can_.isConstructed() || !cyc_.isConstructed() || !filter_.isConstructed() )
+        {
+            break;
+        }
+        if( clock_ <= 0 )
+        {
+            break;
+        }
+        if( !filter_.compile(&rule_, 1, 1) )
+        {
+            break;
+        }
+        if( !can_.setFilter(filter_) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+uint32_t CanBenchmark::getWord(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0])
+        | (static_cast<uint32_t>(data[1]) << 8)
+        | (static_cast<uint32_t>(data[2]) << 16)
+        | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+void CanBenchmark::setWord(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value);
+    data[1] = static_cast<uint8_t>(value >> 8);
+    data[2] = static_cast<uint8_t>(value >> 16);
+    data[3] = static_cast<uint8_t>(value >> 24);
+}
+
+CanBenchmark::Result::Result()
+    : frames(0)
+    , errors(0)
+    , cycles(0)
+    , framesPerSecond(0)
+    , isrCyclesPerFrame(0)
+    , latencyAverage(0)
+    , latencyMax(0) {
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,115 @@
+/**
+ * @file      cpu.CanBitTiming.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanBitTiming.hpp"
+#include "cpu.reg.Can.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanBitTiming::Result::Result()
+    : btr(0)
+    , bitRate(0)
+    , ppm(0)
+    , samplePoint(0) {
+}
+
+bool_t CanBitTiming::calculate(int64_t clock, int64_t bitRate, int32_t samplePoint, Result& result)
+{
+    if( clock <= 0 || bitRate <= 0 || samplePoint <= 0 || samplePoint >= 1000 )
+    {
+        return false;
+    }
+    bool_t isFound( false );
+    int64_t bestError( 0 );
+    int64_t bestDiv( 0 );
+    int32_t bestDistance( 0 );
+    for(int32_t quanta(QUANTA_MAX); quanta>=QUANTA_MIN; quanta--)
+    {
+        int64_t const rate( bitRate * quanta );
+        int64_t const brp( (clock + rate / 2) / rate );
+        if( brp < 1 || brp > BRP_MAX )
+        {
+            continue;
+        }
+        int64_t const div( brp * quanta );
+        int64_t error( clock - bitRate * div );
+        if( error < 0 )
+        {
+            error = -error;
+        }
+        // The sample point is after the synchronization segment and segment 1
+        int32_t segment1( (quanta * samplePoint + 500) / 1000 - 1 );
+        if( segment1 > SEGMENT1_MAX )
+        {
+            segment1 = SEGMENT1_MAX;
+        }
+        if( segment1 < quanta - 1 - SEGMENT2_MAX )
+        {
+            segment1 = quanta - 1 - SEGMENT2_MAX;
+        }
+        if( segment1 > quanta - 2 )
+        {
+            segment1 = quanta - 2;
+        }
+        // A low sample point cannot take segment 1 below one quantum, and segment 2 is too long then
+        if( segment1 < 1 )
+        {
+            segment1 = 1;
+        }
+        int32_t const segment2( quanta - 1 - segment1 );
+        if( segment2 < 1 || segment2 > SEGMENT2_MAX )
+        {
+            continue;
+        }
+        int32_t const achieved( (1 + segment1) * 1000 / quanta );
+        int32_t distance( achieved - samplePoint );
+        if( distance < 0 )
+        {
+            distance = -distance;
+        }
+        // The relative errors |clock / div - bit rate| / bit rate are compared multiplied by both divisors
+        int64_t const lhs( error * bestDiv );
+        int64_t const rhs( bestError * div );
+        if( !isFound || lhs < rhs || (lhs == rhs && distance < bestDistance) )
+        {
+            reg::Can::Btr btr(0);
+            btr.bit.brp = static_cast<reg::Can::Btr::Value>(brp - 1);
+            btr.bit.ts1 = static_cast<reg::Can::Btr::Value>(segment1 - 1);
+            btr.bit.ts2 = static_cast<reg::Can::Btr::Value>(segment2 - 1);
+            btr.bit.sjw = static_cast<reg::Can::Btr::Value>(((segment2 < SJW_MAX) ? segment2 : SJW_MAX) - 1);
+            result.btr = btr.value;
+            result.bitRate = (clock + div / 2) / div;
+            result.ppm = static_cast<int32_t>( (clock * 1000000 - bitRate * div * 1000000) / (bitRate * div) );
+            result.samplePoint = achieved;
+            bestError = error;
+            bestDiv = div;
+            bestDistance = distance;
+            isFound = true;
+        }
+    }
+    return isFound;
+}
+
+bool_t CanBitTiming::getBitTiming(int64_t clock, uint32_t btr, Result& result)
+{
+    reg::Can::Btr const reg( btr );
+    if( clock <= 0 )
+    {
+        return false;
+    }
+    int64_t const quanta( 3 + reg.bit.ts1 + reg.bit.ts2 );
+    int64_t const div( (static_cast<int64_t>(reg.bit.brp) + 1) * quanta );
+    result.btr = btr;
+    result.bitRate = (clock + div / 2) / div;
+    result.ppm = 0;
+    result.samplePoint = static_cast<int32_t>( (2 + reg.bit.ts1) * 1000 / quanta );
+    return true;
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,343 @@
+/**
+ * @file      cpu.CanBusLoad.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanBusLoad.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanBusLoad::CanBusLoad(CanController::Resource& can, api::Guard& gie, CycleCounter& cyc, int64_t clock, const Config& config)
+    : NonCopyable<NoAllocator>()
+    , CanController::Resource::Monitor()
+    , can_(can)
+    , gie_(gie)
+    , cyc_(cyc)
+    , config_(config)
+    , cyclesPerUs_( static_cast<uint32_t>(clock / 1000000) )
+    , periodCycles_(0U)
+    , bucket_(0U)
+    , begin_(0U)
+    , peak_(0U)
+    , frames_(0U)
+    , unrecorded_(0U) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanBusLoad::~CanBusLoad()
+{
+    if( isConstructed() )
+    {
+        static_cast<void>( can_.setMonitor(NULLPTR) );
+    }
+}
+
+bool_t CanBusLoad::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+uint32_t CanBusLoad::getLoad(size_t periods)
+{
+    // The current bucket is not complete, thus it is not in a window
+    if( !isConstructed() || periods == 0U || periods >= config_.numberOfBuckets )
+    {
+        return 0U;
+    }
+    uint64_t bits( 0U );
+    {
+        lib::Guard<NoAllocator> const guard(gie_);
+        advance();
+        for(size_t i(1U); i<=periods; i++)
+        {
+            bits += config_.buckets[(bucket_ + config_.numberOfBuckets - i) % config_.numberOfBuckets];
+        }
+    }
+    return getLoad(bits, periods);
+}
+
+uint32_t CanBusLoad::getPeak()
+{
+    if( !isConstructed() )
+    {
+        return 0U;
+    }
+    uint32_t peak;
+    {
+        lib::Guard<NoAllocator> const guard(gie_);
+        advance();
+        peak = peak_;
+    }
+    return getLoad(peak, 1U);
+}
+
+uint32_t CanBusLoad::getFrames() const
+{
+    return frames_;
+}
+
+uint32_t CanBusLoad::getUnrecorded() const
+{
+    return unrecorded_;
+}
+
+bool_t CanBusLoad::getLatency(size_t index, Latency& latency) const
+{
+    if( !isConstructed() || index >= config_.numberOfLatencies )
+    {
+        return false;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    latency = config_.latencies[index];
+    return true;
+}
+
+void CanBusLoad::reset()
+{
+    if( !isConstructed() )
+    {
+        return;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    for(size_t i(0U); i<config_.numberOfLatencies; i++)
+    {
+        Latency& latency( config_.latencies[i] );
+        latency = Latency(latency.id, latency.isExtended);
+    }
+    peak_ = 0U;
+    unrecorded_ = 0U;
+}
+
+void CanBusLoad::update()
+{
+    if( !isConstructed() )
+    {
+        return;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    advance();
+}
+
+void CanBusLoad::received(const CanController::Resource::RxFrame& frame)
+{
+    count(frame.frame);
+}
+
+void CanBusLoad::transmitted(const CanFrame& frame, uint32_t cycles)
+{
+    count(frame);
+    for(size_t i(0U); i<config_.numberOfLatencies; i++)
+    {
+        Latency& latency( config_.latencies[i] );
+        if( latency.id != frame.id || latency.isExtended != frame.isExtended )
+        {
+            continue;
+        }
+        uint32_t const time( cycles / cyclesPerUs_ );
+        int32_t bin( 0 );
+        while( bin < NUMBER_OF_BINS - 1 && (time >> (bin + 1)) != 0U )
+        {
+            bin++;
+        }
+        latency.frames++;
+        latency.sum += time;
+        if( time > latency.max )
+        {
+            latency.max = time;
+        }
+        latency.histogram[bin]++;
+        return;
+    }
+    unrecorded_++;
+}
+
+uint32_t CanBusLoad::getBits(const CanFrame& frame)
+{
+    Stream stream;
+    uint32_t const rtr( frame.isRemote ? 1U : 0U );
+    put(stream, 0U, 1, true);
+    if( frame.isExtended )
+    {
+        put(stream, frame.id >> 18, 11, true);
+        // SRR and IDE are recessive
+        put(stream, 3U, 2, true);
+        put(stream, frame.id & 0x0003FFFFU, 18, true);
+        put(stream, rtr, 1, true);
+        // Reserved bits r1 and r0 are dominant
+        put(stream, 0U, 2, true);
+    }
+    else
+    {
+        put(stream, frame.id, 11, true);
+        put(stream, rtr, 1, true);
+        // IDE and reserved bit r0 are dominant
+        put(stream, 0U, 2, true);
+    }
+    put(stream, frame.size, 4, true);
+    if( !frame.isRemote )
+    {
+        for(uint8_t i(0U); i<frame.size && i<CanFrame::DATA_SIZE; i++)
+        {
+            put(stream, frame.data[i], 8, true);
+        }
+    }
+    // The CRC sequence is stuffed too
+    put(stream, stream.crc, 15, false);
+    return stream.bits + TAIL_BITS;
+}
+
+bool_t CanBusLoad::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !can_.isConstructed() || !cyc_.isConstructed() )
+        {
+            break;
+        }
+        if( config_.buckets == NULLPTR || config_.numberOfBuckets < 2U )
+        {
+            break;
+        }
+        if( config_.latencies == NULLPTR && config_.numberOfLatencies != 0U )
+        {
+            break;
+        }
+        if( cyclesPerUs_ == 0U || config_.period == 0U || config_.period > 0xFFFFFFFFU / cyclesPerUs_ )
+        {
+            break;
+        }
+        periodCycles_ = config_.period * cyclesPerUs_;
+        for(size_t i(0U); i<config_.numberOfBuckets; i++)
+        {
+            config_.buckets[i] = 0U;
+        }
+        begin_ = cyc_.getCycles();
+        if( !can_.setMonitor(this) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+void CanBusLoad::count(const CanFrame& frame)
+{
+    advance();
+    config_.buckets[bucket_] += getBits(frame);
+    frames_++;
+}
+
+void CanBusLoad::advance()
+{
+    uint32_t const periods( (cyc_.getCycles() - begin_) / periodCycles_ );
+    if( periods == 0U )
+    {
+        return;
+    }
+    begin_ += periods * periodCycles_;
+    uint32_t const bits( config_.buckets[bucket_] );
+    if( bits > peak_ )
+    {
+        peak_ = bits;
+    }
+    // Buckets of periods without frames are cleared, and all of them at most
+    uint32_t const number( static_cast<uint32_t>(config_.numberOfBuckets) );
+    for(uint32_t i(0U); i<periods && i<number; i++)
+    {
+        bucket_ = (bucket_ + 1U) % number;
+        config_.buckets[bucket_] = 0U;
+    }
+}
+
+uint32_t CanBusLoad::getLoad(uint64_t bits, size_t periods) const
+{
+    uint64_t const capacity( static_cast<uint64_t>(periods) * config_.period * static_cast<uint64_t>(can_.getBitTiming().bitRate) );
+    if( capacity == 0U )
+    {
+        return 0U;
+    }
+    return static_cast<uint32_t>(bits * 1000000000U / capacity);
+}
+
+void CanBusLoad::put(Stream& stream, uint32_t value, int32_t number, bool_t isCrc)
+{
+    // CRC-15 polynomial of CAN without its MSB
+    static const uint32_t POLYNOMIAL( 0x4599U );
+    for(int32_t i(number - 1); i>=0; i--)
+    {
+        uint32_t const bit( (value >> i) & 1U );
+        if( isCrc )
+        {
+            uint32_t const next( bit ^ ((stream.crc >> 14) & 1U) );
+            stream.crc = (stream.crc << 1) & 0x00007FFFU;
+            if( next != 0U )
+            {
+                stream.crc ^= POLYNOMIAL;
+            }
+        }
+        stream.bits++;
+        if( bit == stream.level )
+        {
+            stream.run++;
+        }
+        else
+        {
+            stream.level = bit;
+            stream.run = 1U;
+        }
+        // A bit of the opposite level is stuffed after five bits of one level, and it starts a new run
+        if( stream.run == 5U )
+        {
+            stream.bits++;
+            stream.level ^= 1U;
+            stream.run = 1U;
+        }
+    }
+}
+
+CanBusLoad::Latency::Latency()
+    : id(0U)
+    , isExtended(false)
+    , frames(0U)
+    , sum(0U)
+    , max(0U)
+    , histogram() {
+}
+
+CanBusLoad::Latency::Latency(uint32_t aid, bool_t aisExtended)
+    : id(aid)
+    , isExtended(aisExtended)
+    , frames(0U)
+    , sum(0U)
+    , max(0U)
+    , histogram() {
+}
+
+CanBusLoad::Config::Config()
+    : period(10000)
+    , buckets(NULLPTR)
+    , numberOfBuckets(0U)
+    , latencies(NULLPTR)
+    , numberOfLatencies(0U) {
+}
+
+CanBusLoad::Stream::Stream()
+    : crc(0U)
+    , bits(0U)
+    , run(0U)
+    , level(2U) {
+}
+
+} // namespace cpu
+} // namespace eoos
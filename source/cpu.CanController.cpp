@@ -0,0 +1,115 @@
+/**
+ * @file      cpu.CanController.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanController.hpp"
+#include "lib.UniquePointer.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+api::Heap* CanController::resource_( NULLPTR );
+
+CanController::CanController(Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, Gpio& gpio, PllController& pll)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie)
+    , memory_(gie_)
+    , data_(reg_, gie_, ic, gpio, pll) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanController::~CanController()
+{
+    CanController::deinitialize();
+}
+
+bool_t CanController::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+CanController::Resource* CanController::createResource(int32_t index, const Resource::Config& config)
+{
+    Resource* ptr( NULLPTR );
+    if( isConstructed() && Resource::isIndex(index) )
+    {
+        lib::UniquePointer<Resource> res( new Resource(data_, index, config) );
+        if( !res.isNull() )
+        {
+            if( !res->isConstructed() )
+            {
+                res.reset();
+            }
+        }
+        ptr = res.release();
+    }
+    return ptr;
+}
+
+bool_t CanController::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !memory_.isConstructed() )
+        {
+            break;
+        }
+        if( !initialize(&memory_) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+void* CanController::allocate(size_t size)
+{
+    if( resource_ != NULLPTR )
+    {
+        return resource_->allocate(size, NULLPTR);
+    }
+    else
+    {
+        return NULLPTR;
+    }
+}
+
+void CanController::free(void* ptr)
+{
+    if( resource_ != NULLPTR )
+    {
+        resource_->free(ptr);
+    }
+}
+
+bool_t CanController::initialize(api::Heap* resource)
+{
+    if( resource_ != NULLPTR )
+    {
+        return false;
+    }
+    else
+    {
+        resource_ = resource;
+        return true;
+    }
+}
+
+void CanController::deinitialize()
+{
+    resource_ = NULLPTR;
+}
+
+} // namespace cpu
+} // namespace eoos
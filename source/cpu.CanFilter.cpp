@@ -0,0 +1,746 @@
+/**
+ * @file      cpu.CanFilter.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanFilter.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @brief Filter element bits of 32 bits scale.
+ */
+static const uint32_t WIDE_IDE = 0x00000004;
+static const uint32_t WIDE_RTR = 0x00000002;
+
+/**
+ * @brief Filter element bits of 16 bits scale.
+ */
+static const uint32_t NARROW_IDE = 0x00000008;
+static const uint32_t NARROW_RTR = 0x00000010;
+
+CanFilter::CanFilter(Term* buffer, size_t size)
+    : NonCopyable<NoAllocator>()
+    , term_(buffer)
+    , size_(size)
+    , length_(0)
+    , rules_(NULLPTR)
+    , number_(0)
+    , requested_(0)
+    , bank_()
+    , banks_(0)
+    , overAccepted_(0) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanFilter::~CanFilter()
+{
+}
+
+bool_t CanFilter::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t CanFilter::compile(const Rule* rules, size_t number, int32_t banks)
+{
+    bool_t res( false );
+    length_ = 0;
+    rules_ = NULLPTR;
+    number_ = 0;
+    requested_ = 0;
+    banks_ = 0;
+    overAccepted_ = 0;
+    for(int32_t i(0); i<NUMBER_OF_BANKS; i++)
+    {
+        bank_[i] = Bank();
+    }
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( (rules == NULLPTR && number != 0U) || banks < 0 || banks > NUMBER_OF_BANKS )
+        {
+            break;
+        }
+        rules_ = rules;
+        number_ = number;
+        if( !split() )
+        {
+            break;
+        }
+        // Merging is not stopped when the terms first fit the banks, as a merge may change kinds
+        // of terms so that terms of more merges fit with less identifiers accepted, thus terms of
+        // the least merges of the least over-acceptance are made again
+        int32_t merges( -1 );
+        uint32_t least( 0U );
+        int32_t i( 0 );
+        while( true )
+        {
+            if( getRequiredBanks() <= banks )
+            {
+                uint32_t const overAccepted( getTermsOverAccepted() );
+                if( merges == -1 || overAccepted < least )
+                {
+                    merges = i;
+                    least = overAccepted;
+                }
+            }
+            if( !merge() )
+            {
+                break;
+            }
+            i++;
+        }
+        if( merges == -1 )
+        {
+            // Each format has one term, and the formats do not fit
+            break;
+        }
+        length_ = 0;
+        requested_ = 0;
+        static_cast<void>( split() );
+        for(i=0; i<merges; i++)
+        {
+            static_cast<void>( merge() );
+        }
+        pack();
+        balance();
+        overAccepted_ = least;
+        res = true;
+    } while(false);
+    if( !res )
+    {
+        rules_ = NULLPTR;
+        number_ = 0;
+        banks_ = 0;
+    }
+    return res;
+}
+
+int32_t CanFilter::getBanks() const
+{
+    return banks_;
+}
+
+const CanFilter::Bank& CanFilter::getBank(int32_t index) const
+{
+    return bank_[index];
+}
+
+uint32_t CanFilter::getOverAccepted() const
+{
+    return overAccepted_;
+}
+
+bool_t CanFilter::isExact(int32_t fifo, uint32_t fmi) const
+{
+    // Filter elements are numbered for each FIFO in order of banks
+    uint32_t first( 0U );
+    for(int32_t i(0); i<banks_; i++)
+    {
+        Bank const& bank( bank_[i] );
+        if( bank.fifo != fifo )
+        {
+            continue;
+        }
+        uint32_t const elements( static_cast<uint32_t>(bank.elements) );
+        if( fmi < first + elements )
+        {
+            return (bank.exact & (1U << (fmi - first))) != 0U;
+        }
+        first += elements;
+    }
+    return false;
+}
+
+bool_t CanFilter::isRequested(const CanFrame& frame) const
+{
+    if( frame.isRemote )
+    {
+        return false;
+    }
+    for(size_t i(0U); i<number_; i++)
+    {
+        Rule const& rule( rules_[i] );
+        if( rule.isExtended == frame.isExtended && rule.first <= frame.id && frame.id <= rule.last )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool_t CanFilter::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( term_ == NULLPTR || size_ == 0U )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+bool_t CanFilter::split()
+{
+    for(size_t i(0U); i<number_; i++)
+    {
+        Rule const& rule( rules_[i] );
+        if( rule.first > rule.last || rule.last > getFullMask(rule.isExtended) )
+        {
+            return false;
+        }
+    }
+    for(int32_t format(0); format<2; format++)
+    {
+        bool_t const isExtended( format != 0 );
+        uint32_t const full( getFullMask(isExtended) );
+        uint32_t first( 0U );
+        uint32_t last( 0U );
+        uint32_t from( 0U );
+        while( getRange(isExtended, from, first, last) )
+        {
+            uint32_t id( first );
+            while( true )
+            {
+                // Take the largest aligned block which starts from the identifier and fits the range
+                uint32_t size( 1U );
+                while( (id & size) == 0U && id + (size << 1) - 1U <= last )
+                {
+                    size <<= 1;
+                }
+                if( length_ == size_ )
+                {
+                    return false;
+                }
+                Term& term( term_[length_++] );
+                term.value = id;
+                term.mask = full & ~(size - 1U);
+                term.requested = size;
+                term.isExtended = isExtended;
+                if( id + size - 1U >= last )
+                {
+                    break;
+                }
+                id += size;
+            }
+            requested_ = add(requested_, last - first + 1U);
+            if( last == full )
+            {
+                break;
+            }
+            from = last + 1U;
+        }
+    }
+    return true;
+}
+
+bool_t CanFilter::getRange(bool_t isExtended, uint32_t from, uint32_t& first, uint32_t& last) const
+{
+    bool_t isFound( false );
+    for(size_t i(0U); i<number_; i++)
+    {
+        Rule const& rule( rules_[i] );
+        if( rule.isExtended != isExtended || rule.last < from )
+        {
+            continue;
+        }
+        uint32_t const begin( (rule.first > from) ? rule.first : from );
+        if( !isFound || begin < first )
+        {
+            first = begin;
+            isFound = true;
+        }
+    }
+    if( !isFound )
+    {
+        return false;
+    }
+    // Join rules which overlap or adjoin the range until it does not change
+    last = first;
+    bool_t isChanged( true );
+    while( isChanged )
+    {
+        isChanged = false;
+        for(size_t i(0U); i<number_; i++)
+        {
+            Rule const& rule( rules_[i] );
+            if( rule.isExtended == isExtended && rule.first <= last + 1U && rule.last > last )
+            {
+                last = rule.last;
+                isChanged = true;
+            }
+        }
+    }
+    return true;
+}
+
+bool_t CanFilter::merge()
+{
+    size_t first( 0U );
+    size_t second( 0U );
+    Term best;
+    bool_t isFound( false );
+    uint32_t bestExtra( 0U );
+    uint32_t bestSaving( 0U );
+    for(size_t i(0U); i<length_; i++)
+    {
+        for(size_t j(i + 1U); j<length_; j++)
+        {
+            Term const& a( term_[i] );
+            Term const& b( term_[j] );
+            if( a.isExtended != b.isExtended )
+            {
+                continue;
+            }
+            Term merged;
+            merged.mask = a.mask & b.mask & ~(a.value ^ b.value);
+            merged.value = a.value & merged.mask;
+            merged.isExtended = a.isExtended;
+            uint32_t const accepted( getAccepted(merged) );
+            uint32_t const own( add(getAccepted(a), getAccepted(b)) );
+            uint32_t const extra( accepted > own ? accepted - own : 0U );
+            uint32_t const saving( getCost(a) + getCost(b) - getCost(merged) );
+            // Take the least extra identifiers per element space saved, which is counted
+            // from one as a merge saving nothing makes a mask for next merges
+            bool_t isBetter( !isFound );
+            if( !isBetter )
+            {
+                uint64_t const lhs( static_cast<uint64_t>(extra) * (bestSaving + 1U) );
+                uint64_t const rhs( static_cast<uint64_t>(bestExtra) * (saving + 1U) );
+                isBetter = lhs < rhs || (lhs == rhs && saving > bestSaving);
+            }
+            if( isBetter )
+            {
+                isFound = true;
+                first = i;
+                second = j;
+                best = merged;
+                bestExtra = extra;
+                bestSaving = saving;
+            }
+        }
+    }
+    if( !isFound )
+    {
+        return false;
+    }
+    // Remove the pair by moving last terms to their places, the second one first
+    term_[second] = term_[--length_];
+    term_[first] = term_[--length_];
+    // Drop terms covered by the merged one
+    size_t i( 0U );
+    while( i < length_ )
+    {
+        Term const& term( term_[i] );
+        if( term.isExtended == best.isExtended && (term.mask & best.mask) == best.mask && (term.value & best.mask) == best.value )
+        {
+            term_[i] = term_[--length_];
+        }
+        else
+        {
+            i++;
+        }
+    }
+    best.requested = getRequested(best);
+    term_[length_++] = best;
+    return true;
+}
+
+int32_t CanFilter::getRequiredBanks() const
+{
+    size_t count[NUMBER_OF_KINDS] = {0U, 0U, 0U, 0U};
+    for(size_t i(0U); i<length_; i++)
+    {
+        count[getKind(term_[i])]++;
+    }
+    return getBanks(count);
+}
+
+uint32_t CanFilter::getTermsOverAccepted() const
+{
+    // Each identifier is counted by the last term which accepts it, and the terms accept all requested ones
+    uint32_t accepted( 0U );
+    for(size_t i(0U); i<length_; i++)
+    {
+        accepted = add(accepted, getUncovered(term_[i], i + 1U));
+    }
+    return ( accepted > requested_ ) ? accepted - requested_ : 0U;
+}
+
+uint32_t CanFilter::getUncovered(const Term& term, size_t from) const
+{
+    for(size_t i(from); i<length_; i++)
+    {
+        Term const& other( term_[i] );
+        if( other.isExtended != term.isExtended || ((term.value ^ other.value) & term.mask & other.mask) != 0U )
+        {
+            continue;
+        }
+        uint32_t const bits( other.mask & ~term.mask );
+        if( bits == 0U )
+        {
+            return 0U;
+        }
+        // Split the term by the bits the other term matches to parts out of the other term,
+        // and the last part, which is in the other term, is not counted
+        uint32_t uncovered( 0U );
+        Term part( term );
+        for(uint32_t bit(1U); bit != 0U && bit <= bits; bit <<= 1)
+        {
+            if( (bits & bit) == 0U )
+            {
+                continue;
+            }
+            part.mask |= bit;
+            part.value = (part.value & ~bit) | (~other.value & bit);
+            uncovered = add(uncovered, getUncovered(part, i + 1U));
+            part.value ^= bit;
+        }
+        return uncovered;
+    }
+    return getAccepted(term);
+}
+
+uint32_t CanFilter::getRequested(const Term& term) const
+{
+    uint32_t const full( getFullMask(term.isExtended) );
+    uint32_t requested( 0U );
+    uint32_t first( 0U );
+    uint32_t last( 0U );
+    uint32_t from( 0U );
+    while( getRange(term.isExtended, from, first, last) )
+    {
+        uint32_t const below( (first == 0U) ? 0U : getAccepted(term, first - 1U) );
+        requested = add(requested, getAccepted(term, last) - below);
+        if( last == full )
+        {
+            break;
+        }
+        from = last + 1U;
+    }
+    return requested;
+}
+
+void CanFilter::pack()
+{
+    size_t count[NUMBER_OF_KINDS] = {0U, 0U, 0U, 0U};
+    for(size_t i(0U); i<length_; i++)
+    {
+        count[getKind(term_[i])]++;
+    }
+    int32_t spareWide( -1 );
+    int32_t spareNarrow( -1 );
+    int32_t list( -1 );
+    // Standard identifiers left over from full list banks use free elements of other banks if they fit
+    size_t const rest( count[KIND_STANDARD_ID] % 4U );
+    size_t const spares( (count[KIND_EXTENDED_ID] % 2U) + (count[KIND_STANDARD_MASK] % 2U) );
+    size_t listed( count[KIND_STANDARD_ID] - ((rest <= spares) ? rest : 0U) );
+    for(int32_t kind(0); kind<NUMBER_OF_KINDS; kind++)
+    {
+        for(size_t i(0U); i<length_; i++)
+        {
+            Term const& term( term_[i] );
+            if( getKind(term) != kind )
+            {
+                continue;
+            }
+            Bank* bank( NULLPTR );
+            switch( kind )
+            {
+                case KIND_EXTENDED_MASK:
+                {
+                    bank = &bank_[banks_++];
+                    bank->isWide = true;
+                    break;
+                }
+                case KIND_EXTENDED_ID:
+                {
+                    if( spareWide == -1 )
+                    {
+                        spareWide = banks_;
+                        bank = &bank_[banks_++];
+                        bank->isWide = true;
+                        bank->isList = true;
+                    }
+                    else
+                    {
+                        bank = &bank_[spareWide];
+                        spareWide = -1;
+                    }
+                    break;
+                }
+                case KIND_STANDARD_MASK:
+                {
+                    if( spareNarrow == -1 )
+                    {
+                        spareNarrow = banks_;
+                        bank = &bank_[banks_++];
+                    }
+                    else
+                    {
+                        bank = &bank_[spareNarrow];
+                        spareNarrow = -1;
+                    }
+                    break;
+                }
+                default:
+                {
+                    if( listed == 0U )
+                    {
+                        if( spareWide != -1 )
+                        {
+                            bank = &bank_[spareWide];
+                            spareWide = -1;
+                        }
+                        else
+                        {
+                            bank = &bank_[spareNarrow];
+                            spareNarrow = -1;
+                        }
+                        break;
+                    }
+                    if( list == -1 || bank_[list].elements == 4 )
+                    {
+                        list = banks_;
+                        bank_[list].isList = true;
+                        banks_++;
+                    }
+                    bank = &bank_[list];
+                    listed--;
+                    break;
+                }
+            }
+            put(*bank, term);
+        }
+    }
+    // Free elements repeat the first one to not accept anything else
+    for(int32_t i(0); i<banks_; i++)
+    {
+        Bank& bank( bank_[i] );
+        int32_t const capacity( bank.isWide ? (bank.isList ? 2 : 1) : (bank.isList ? 4 : 2) );
+        uint32_t const first( (!bank.isWide && bank.isList) ? (bank.fr1 & 0x0000FFFFU) : bank.fr1 );
+        for(int32_t e(bank.elements); e<capacity; e++)
+        {
+            if( bank.isWide || !bank.isList )
+            {
+                bank.fr2 = first;
+            }
+            else if( e == 1 )
+            {
+                bank.fr1 |= first << 16;
+            }
+            else if( e == 2 )
+            {
+                bank.fr2 = first;
+            }
+            else
+            {
+                bank.fr2 |= first << 16;
+            }
+            bank.exact |= (bank.exact & 1U) << e;
+        }
+        bank.elements = capacity;
+    }
+}
+
+void CanFilter::balance()
+{
+    int32_t order[NUMBER_OF_BANKS];
+    for(int32_t i(0); i<banks_; i++)
+    {
+        int32_t j( i );
+        while( j > 0 && bank_[order[j - 1]].weight < bank_[i].weight )
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    uint32_t load[2] = {0U, 0U};
+    for(int32_t i(0); i<banks_; i++)
+    {
+        Bank& bank( bank_[order[i]] );
+        bank.fifo = (load[1] < load[0]) ? 1 : 0;
+        load[bank.fifo] = add(load[bank.fifo], bank.weight);
+    }
+}
+
+void CanFilter::put(Bank& bank, const Term& term)
+{
+    int32_t const e( bank.elements );
+    if( bank.isWide )
+    {
+        uint32_t const id( term.isExtended ? ((term.value << 3) | WIDE_IDE) : (term.value << 21) );
+        if( bank.isList )
+        {
+            ((e == 0) ? bank.fr1 : bank.fr2) = id;
+        }
+        else
+        {
+            bank.fr1 = id;
+            bank.fr2 = (term.isExtended ? (term.mask << 3) : (term.mask << 21)) | WIDE_IDE | WIDE_RTR;
+        }
+    }
+    else
+    {
+        uint32_t const id( term.value << 5 );
+        if( bank.isList )
+        {
+            uint32_t& fr( (e < 2) ? bank.fr1 : bank.fr2 );
+            fr |= id << (((e & 1) != 0) ? 16 : 0);
+        }
+        else
+        {
+            uint32_t const mask( (term.mask << 5) | NARROW_IDE | NARROW_RTR );
+            ((e == 0) ? bank.fr1 : bank.fr2) = id | (mask << 16);
+        }
+    }
+    if( getAccepted(term) <= term.requested )
+    {
+        bank.exact |= 1U << e;
+    }
+    bank.weight = add(bank.weight, term.requested);
+    bank.elements++;
+}
+
+int32_t CanFilter::getBanks(const size_t* count)
+{
+    size_t banks( count[KIND_EXTENDED_MASK] + (count[KIND_EXTENDED_ID] / 2U) + (count[KIND_STANDARD_MASK] / 2U) + (count[KIND_STANDARD_ID] / 4U) );
+    size_t const spares( (count[KIND_EXTENDED_ID] % 2U) + (count[KIND_STANDARD_MASK] % 2U) );
+    banks += spares;
+    if( count[KIND_STANDARD_ID] % 4U > spares )
+    {
+        banks++;
+    }
+    return static_cast<int32_t>(banks);
+}
+
+uint32_t CanFilter::getCost(const Term& term)
+{
+    // Quarters of a bank a filter element takes
+    static const uint32_t COST[NUMBER_OF_KINDS] = {4U, 2U, 2U, 1U};
+    return COST[getKind(term)];
+}
+
+CanFilter::Kind CanFilter::getKind(const Term& term)
+{
+    bool_t const isSingle( term.mask == getFullMask(term.isExtended) );
+    if( term.isExtended )
+    {
+        return isSingle ? KIND_EXTENDED_ID : KIND_EXTENDED_MASK;
+    }
+    return isSingle ? KIND_STANDARD_ID : KIND_STANDARD_MASK;
+}
+
+uint32_t CanFilter::getAccepted(const Term& term)
+{
+    return getAccepted(getFullMask(term.isExtended) & ~term.mask);
+}
+
+uint32_t CanFilter::getAccepted(uint32_t free)
+{
+    uint32_t bits( 0U );
+    while( free != 0U )
+    {
+        free &= free - 1U;
+        bits++;
+    }
+    return 1U << bits;
+}
+
+uint32_t CanFilter::getAccepted(const Term& term, uint32_t last)
+{
+    // Identifiers with the bits from the MSB which are less than bits of the last one first are counted
+    uint32_t const full( getFullMask(term.isExtended) );
+    uint32_t accepted( 0U );
+    for(uint32_t bit( (full >> 1) + 1U ); bit != 0U; bit >>= 1)
+    {
+        bool_t const isFixed( (term.mask & bit) != 0U );
+        bool_t const isOne( (term.value & bit) != 0U );
+        if( (last & bit) != 0U )
+        {
+            if( !isFixed || !isOne )
+            {
+                accepted = add(accepted, getAccepted(full & ~term.mask & (bit - 1U)));
+            }
+            if( isFixed && !isOne )
+            {
+                return accepted;
+            }
+        }
+        else if( isFixed && isOne )
+        {
+            return accepted;
+        }
+        else
+        {
+        }
+    }
+    // The last identifier is accepted too
+    return add(accepted, 1U);
+}
+
+uint32_t CanFilter::getFullMask(bool_t isExtended)
+{
+    return isExtended ? CanFrame::EXTENDED_ID_MAX : CanFrame::STANDARD_ID_MAX;
+}
+
+uint32_t CanFilter::add(uint32_t a, uint32_t b)
+{
+    uint32_t const sum( a + b );
+    return (sum < a) ? 0xFFFFFFFFU : sum;
+}
+
+CanFilter::Rule::Rule()
+    : first(0)
+    , last(0)
+    , isExtended(false) {
+}
+
+CanFilter::Rule::Rule(uint32_t aid, bool_t aisExtended)
+    : first(aid)
+    , last(aid)
+    , isExtended(aisExtended) {
+}
+
+CanFilter::Rule::Rule(uint32_t afirst, uint32_t alast, bool_t aisExtended)
+    : first(afirst)
+    , last(alast)
+    , isExtended(aisExtended) {
+}
+
+CanFilter::Term::Term()
+    : value(0)
+    , mask(0)
+    , requested(0)
+    , isExtended(false) {
+}
+
+CanFilter::Bank::Bank()
+    : isList(false)
+    , isWide(false)
+    , fifo(0)
+    , fr1(0)
+    , fr2(0)
+    , elements(0)
+    , exact(0)
+    , weight(0) {
+}
+
+} // namespace cpu
+} // namespace eoos
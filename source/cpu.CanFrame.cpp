@@ -0,0 +1,39 @@
+/**
+ * @file      cpu.CanFrame.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanFrame.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanFrame::CanFrame()
+    : id(0)
+    , isExtended(false)
+    , isRemote(false)
+    , size(0)
+    , data() {
+}
+
+bool_t CanFrame::isFrame() const
+{
+    uint32_t const max( isExtended ? EXTENDED_ID_MAX : STANDARD_ID_MAX );
+    return id <= max && size <= DATA_SIZE;
+}
+
+uint32_t CanFrame::getArbitration() const
+{
+    uint32_t const rtr( isRemote ? 1U : 0U );
+    if( isExtended )
+    {
+        // The base identifier is the 11 MSBs of the identifier, and SRR is recessive
+        return ((id >> 18) << 21) | (1U << 20) | (1U << 19) | ((id & 0x0003FFFFU) << 1) | rtr;
+    }
+    return (id << 21) | (rtr << 20);
+}
+
+} // namespace cpu
+} // namespace eoos
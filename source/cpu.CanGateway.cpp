@@ -0,0 +1,125 @@
+/**
+ * @file      cpu.CanGateway.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanGateway.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanGateway::CanGateway(CanController::Resource& source, Transport& destination, const Route* routes, size_t number, CanController::Resource::Listener* next)
+    : NonCopyable<NoAllocator>()
+    , CanController::Resource::Listener()
+    , source_(source)
+    , destination_(destination)
+    , routes_(routes)
+    , number_(number)
+    , next_(next)
+    , forwarded_(0U)
+    , dropped_(0U) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanGateway::~CanGateway()
+{
+    if( isConstructed() )
+    {
+        static_cast<void>( source_.setListener(next_) );
+    }
+}
+
+bool_t CanGateway::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t CanGateway::accept(const CanController::Resource::RxFrame& frame)
+{
+    if( !isRouted(frame.frame) )
+    {
+        return ( next_ != NULLPTR ) ? next_->accept(frame) : false;
+    }
+    // The frame is consumed even if it is dropped, as the gateway is its only receiver
+    if( destination_.transmit(frame.frame) )
+    {
+        forwarded_++;
+    }
+    else
+    {
+        dropped_++;
+    }
+    return true;
+}
+
+uint32_t CanGateway::getForwarded() const
+{
+    return forwarded_;
+}
+
+uint32_t CanGateway::getDropped() const
+{
+    return dropped_;
+}
+
+bool_t CanGateway::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !source_.isConstructed() )
+        {
+            break;
+        }
+        if( routes_ == NULLPTR || number_ == 0U )
+        {
+            break;
+        }
+        if( !source_.setListener(this) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+bool_t CanGateway::isRouted(const CanFrame& frame) const
+{
+    // Remote frames are not forwarded as their responses would not be routed back
+    if( frame.isRemote )
+    {
+        return false;
+    }
+    for(size_t i(0U); i<number_; i++)
+    {
+        Route const& route( routes_[i] );
+        if( route.isExtended == frame.isExtended && ((frame.id ^ route.value) & route.mask) == 0U )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+CanGateway::Route::Route()
+    : value(0U)
+    , mask(0U)
+    , isExtended(false) {
+}
+
+CanGateway::Route::Route(uint32_t avalue, uint32_t amask, bool_t aisExtended)
+    : value(avalue)
+    , mask(amask)
+    , isExtended(aisExtended) {
+}
+
+} // namespace cpu
+} // namespace eoos
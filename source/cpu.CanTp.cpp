@@ -0,0 +1,657 @@
+/**
+ * @file      cpu.CanTp.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CanTp.hpp"
+#include "cpu.Interrupt.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CanTp::CanTp(CanController::Resource& can, Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, PllController& pll, CycleCounter& cyc, const Config& config)
+    : NonCopyable<NoAllocator>()
+    , CanController::Resource::Listener()
+    , api::Runnable()
+    , can_(can)
+    , reg_(reg)
+    , gie_(gie)
+    , ic_(ic)
+    , cyc_(cyc)
+    , config_(config)
+    , cyclesPerUs_( static_cast<uint32_t>(pll.getCpuClock() / 1000000) )
+    , timerClock_( pll.getApb1Clock() )
+    , timInt_(NULLPTR)
+    , tim_(NULLPTR)
+    , txData_(NULLPTR)
+    , txSize_(0U)
+    , txOffset_(0U)
+    , txSequence_(0U)
+    , txBlockSize_(0U)
+    , txBlock_(0U)
+    , txStMin_(0U)
+    , txPhase_(PHASE_IDLE)
+    , txDeadline_(0U)
+    , txStatus_(STATUS_IDLE)
+    , rxBuffer_(NULLPTR)
+    , rxSize_(0U)
+    , rxLength_(0U)
+    , rxOffset_(0U)
+    , rxSequence_(0U)
+    , rxBlock_(0U)
+    , rxPhase_(PHASE_IDLE)
+    , rxDeadline_(0U)
+    , rxStatus_(STATUS_IDLE) {
+    // Timers of APB1 are clocked twice faster than APB1 if APB1 prescaler is not 1
+    if( timerClock_ != pll.getAhbClock() )
+    {
+        timerClock_ *= 2;
+    }
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CanTp::~CanTp()
+{
+    if( isConstructed() )
+    {
+        static_cast<void>( can_.setListener(NULLPTR) );
+    }
+    if( timInt_ != NULLPTR )
+    {
+        timInt_->disable();
+        if( tim_ != NULLPTR )
+        {
+            lib::Guard<NoAllocator> const guard(gie_);
+            tim_->cr1.value = 0;
+            tim_->dier.value = 0;
+            enableTimerClock(false);
+        }
+        delete timInt_;
+        timInt_ = NULLPTR;
+    }
+}
+
+bool_t CanTp::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t CanTp::send(const uint8_t* data, size_t size)
+{
+    if( !isConstructed() || data == NULLPTR || size == 0U )
+    {
+        return false;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    if( txPhase_ != PHASE_IDLE )
+    {
+        return false;
+    }
+    uint8_t frame[FRAME_SIZE];
+    if( size <= SINGLE_SIZE )
+    {
+        frame[0] = static_cast<uint8_t>((PCI_SINGLE << 4) | size);
+        for(size_t i(0U); i<size; i++)
+        {
+            frame[i + 1U] = data[i];
+        }
+        if( !transmit(frame, size + 1U) )
+        {
+            return false;
+        }
+        txSize_ = size;
+        txOffset_ = size;
+        finishTx(STATUS_DONE);
+        return true;
+    }
+    size_t header( 2U );
+    if( size <= SHORT_SIZE )
+    {
+        frame[0] = static_cast<uint8_t>((PCI_FIRST << 4) | (size >> 8));
+        frame[1] = static_cast<uint8_t>(size);
+    }
+    else
+    {
+        // The escape sequence of a zero 12 bits length is followed by a 32 bits length
+        uint32_t const length( static_cast<uint32_t>(size) );
+        frame[0] = static_cast<uint8_t>(PCI_FIRST << 4);
+        frame[1] = 0U;
+        frame[2] = static_cast<uint8_t>(length >> 24);
+        frame[3] = static_cast<uint8_t>(length >> 16);
+        frame[4] = static_cast<uint8_t>(length >> 8);
+        frame[5] = static_cast<uint8_t>(length);
+        header = 6U;
+    }
+    for(size_t i(header); i<FRAME_SIZE; i++)
+    {
+        frame[i] = data[i - header];
+    }
+    if( !transmit(frame, FRAME_SIZE) )
+    {
+        return false;
+    }
+    txData_ = data;
+    txSize_ = size;
+    txOffset_ = FRAME_SIZE - header;
+    txSequence_ = 1U;
+    txStatus_ = STATUS_BUSY;
+    txPhase_ = PHASE_WAIT;
+    txDeadline_ = getDeadline(config_.timeout);
+    schedule();
+    return true;
+}
+
+bool_t CanTp::receive(uint8_t* buffer, size_t size)
+{
+    if( !isConstructed() || buffer == NULLPTR || size == 0U )
+    {
+        return false;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    if( rxBuffer_ != NULLPTR )
+    {
+        return false;
+    }
+    rxSize_ = size;
+    rxLength_ = 0U;
+    rxOffset_ = 0U;
+    rxStatus_ = STATUS_IDLE;
+    rxBuffer_ = buffer;
+    return true;
+}
+
+CanTp::Status CanTp::getTxStatus() const
+{
+    return txStatus_;
+}
+
+CanTp::Status CanTp::getRxStatus() const
+{
+    return rxStatus_;
+}
+
+size_t CanTp::getRxLength() const
+{
+    return rxLength_;
+}
+
+bool_t CanTp::accept(const CanController::Resource::RxFrame& rx)
+{
+    CanFrame const& frame( rx.frame );
+    if( frame.id != config_.rxId || frame.isExtended != config_.isExtended || frame.isRemote || frame.size == 0U )
+    {
+        return false;
+    }
+    switch( frame.data[0] >> 4 )
+    {
+        case PCI_SINGLE:
+        {
+            handleSingle(frame);
+            break;
+        }
+        case PCI_FIRST:
+        {
+            handleFirst(frame);
+            break;
+        }
+        case PCI_CONSECUTIVE:
+        {
+            handleConsecutive(frame);
+            break;
+        }
+        case PCI_FLOW:
+        {
+            handleFlow(frame);
+            break;
+        }
+        default:
+        {
+            // Unknown frames are ignored
+            break;
+        }
+    }
+    schedule();
+    return true;
+}
+
+void CanTp::start()
+{
+    tim_->sr.value = 0;
+    if( txPhase_ == PHASE_SEND && isExpired(txDeadline_) )
+    {
+        sendConsecutive();
+    }
+    else if( txPhase_ == PHASE_WAIT && isExpired(txDeadline_) )
+    {
+        finishTx(STATUS_TIMEOUT);
+    }
+    if( rxPhase_ == PHASE_WAIT && isExpired(rxDeadline_) )
+    {
+        finishRx(STATUS_TIMEOUT);
+    }
+    schedule();
+}
+
+bool_t CanTp::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !can_.isConstructed() || !cyc_.isConstructed() )
+        {
+            break;
+        }
+        if( config_.timer != Registers::INDEX_TIM6 && config_.timer != Registers::INDEX_TIM7 )
+        {
+            break;
+        }
+        // Deadlines are compared by the sign of their difference with the cycle counter
+        if( cyclesPerUs_ == 0U || config_.timeout == 0U || config_.timeout > 0x7FFFFFFFU / cyclesPerUs_ )
+        {
+            break;
+        }
+        if( !initializeTimer() )
+        {
+            break;
+        }
+        if( !can_.setListener(this) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+bool_t CanTp::initializeTimer()
+{
+    int32_t const exception( ( config_.timer == Registers::INDEX_TIM6 ) ? Interrupt<NoAllocator>::EXCEPTION_TIM6 : Interrupt<NoAllocator>::EXCEPTION_TIM7 );
+    timInt_ = ic_.createResource(*this, exception);
+    if( timInt_ == NULLPTR )
+    {
+        return false;
+    }
+    if( !timInt_->isConstructed() )
+    {
+        delete timInt_;
+        timInt_ = NULLPTR;
+        return false;
+    }
+    int64_t const psc( timerClock_ / (1000000 / TIMER_TICK) - 1 );
+    if( psc < 0 || psc > 0x0000FFFF )
+    {
+        return false;
+    }
+    tim_ = reg_.tim[config_.timer];
+    {
+        lib::Guard<NoAllocator> const guard(gie_);
+        enableTimerClock(true);
+        tim_->cr1.value = 0;
+        tim_->psc.value = static_cast<reg::Tim::Cnt::Value>(psc);
+        // Load the prescaler, and clear UIF set by the load
+        tim_->egr.bit.ug = 1;
+        tim_->sr.value = 0;
+        tim_->dier.bit.uie = 1;
+    }
+    timInt_->enable();
+    return true;
+}
+
+void CanTp::handleSingle(const CanFrame& frame)
+{
+    size_t const length( frame.data[0] & 0x0FU );
+    if( length == 0U || length >= frame.size || rxBuffer_ == NULLPTR )
+    {
+        return;
+    }
+    // A single frame terminates a message being received
+    if( length > rxSize_ )
+    {
+        finishRx(STATUS_OVERFLOW);
+        return;
+    }
+    for(size_t i(0U); i<length; i++)
+    {
+        rxBuffer_[i] = frame.data[i + 1U];
+    }
+    rxLength_ = length;
+    rxOffset_ = length;
+    finishRx(STATUS_DONE);
+}
+
+void CanTp::handleFirst(const CanFrame& frame)
+{
+    if( frame.size != FRAME_SIZE )
+    {
+        return;
+    }
+    uint32_t length( (static_cast<uint32_t>(frame.data[0] & 0x0FU) << 8) | frame.data[1] );
+    size_t header( 2U );
+    if( length == 0U )
+    {
+        length = (static_cast<uint32_t>(frame.data[2]) << 24) | (static_cast<uint32_t>(frame.data[3]) << 16)
+               | (static_cast<uint32_t>(frame.data[4]) << 8) | frame.data[5];
+        header = 6U;
+        if( length <= SHORT_SIZE )
+        {
+            return;
+        }
+    }
+    if( length <= SINGLE_SIZE )
+    {
+        return;
+    }
+    // A sender is stopped if no buffer is given, as the message cannot be received
+    if( rxBuffer_ == NULLPTR || length > rxSize_ )
+    {
+        static_cast<void>( sendFlow(FLOW_OVERFLOW) );
+        if( rxBuffer_ != NULLPTR )
+        {
+            finishRx(STATUS_OVERFLOW);
+        }
+        return;
+    }
+    // A first frame restarts a message being received
+    for(size_t i(header); i<FRAME_SIZE; i++)
+    {
+        rxBuffer_[i - header] = frame.data[i];
+    }
+    rxLength_ = length;
+    rxOffset_ = FRAME_SIZE - header;
+    rxSequence_ = 1U;
+    rxBlock_ = 0U;
+    rxStatus_ = STATUS_BUSY;
+    rxPhase_ = PHASE_WAIT;
+    rxDeadline_ = getDeadline(config_.timeout);
+    if( !sendFlow(FLOW_CONTINUE) )
+    {
+        finishRx(STATUS_ERROR);
+    }
+}
+
+void CanTp::handleConsecutive(const CanFrame& frame)
+{
+    if( rxPhase_ != PHASE_WAIT )
+    {
+        return;
+    }
+    if( (frame.data[0] & 0x0FU) != rxSequence_ )
+    {
+        finishRx(STATUS_ERROR);
+        return;
+    }
+    size_t count( rxLength_ - rxOffset_ );
+    if( count > SINGLE_SIZE )
+    {
+        count = SINGLE_SIZE;
+    }
+    if( count >= frame.size )
+    {
+        finishRx(STATUS_ERROR);
+        return;
+    }
+    for(size_t i(0U); i<count; i++)
+    {
+        rxBuffer_[rxOffset_ + i] = frame.data[i + 1U];
+    }
+    rxOffset_ += count;
+    rxSequence_ = static_cast<uint8_t>((rxSequence_ + 1U) & 0x0FU);
+    if( rxOffset_ == rxLength_ )
+    {
+        finishRx(STATUS_DONE);
+        return;
+    }
+    rxDeadline_ = getDeadline(config_.timeout);
+    if( config_.blockSize == 0U )
+    {
+        return;
+    }
+    rxBlock_++;
+    if( rxBlock_ == config_.blockSize )
+    {
+        rxBlock_ = 0U;
+        if( !sendFlow(FLOW_CONTINUE) )
+        {
+            finishRx(STATUS_ERROR);
+        }
+    }
+}
+
+void CanTp::handleFlow(const CanFrame& frame)
+{
+    if( txPhase_ != PHASE_WAIT )
+    {
+        return;
+    }
+    if( frame.size < 3U )
+    {
+        finishTx(STATUS_ERROR);
+        return;
+    }
+    switch( frame.data[0] & 0x0FU )
+    {
+        case FLOW_CONTINUE:
+        {
+            txBlockSize_ = frame.data[1];
+            txBlock_ = 0U;
+            txStMin_ = getSeparationTime(frame.data[2]);
+            txPhase_ = PHASE_SEND;
+            sendConsecutive();
+            break;
+        }
+        case FLOW_WAIT:
+        {
+            txDeadline_ = getDeadline(config_.timeout);
+            break;
+        }
+        case FLOW_OVERFLOW:
+        {
+            finishTx(STATUS_OVERFLOW);
+            break;
+        }
+        default:
+        {
+            finishTx(STATUS_ERROR);
+            break;
+        }
+    }
+}
+
+void CanTp::sendConsecutive()
+{
+    while( true )
+    {
+        uint8_t frame[FRAME_SIZE];
+        size_t count( txSize_ - txOffset_ );
+        if( count > SINGLE_SIZE )
+        {
+            count = SINGLE_SIZE;
+        }
+        frame[0] = static_cast<uint8_t>((PCI_CONSECUTIVE << 4) | txSequence_);
+        for(size_t i(0U); i<count; i++)
+        {
+            frame[i + 1U] = txData_[txOffset_ + i];
+        }
+        if( !transmit(frame, count + 1U) )
+        {
+            // The CAN queue is full, thus try again on the next timer tick
+            txDeadline_ = getDeadline(TIMER_TICK);
+            return;
+        }
+        txOffset_ += count;
+        txSequence_ = static_cast<uint8_t>((txSequence_ + 1U) & 0x0FU);
+        if( txOffset_ == txSize_ )
+        {
+            finishTx(STATUS_DONE);
+            return;
+        }
+        if( txBlockSize_ != 0U )
+        {
+            txBlock_++;
+            if( txBlock_ == txBlockSize_ )
+            {
+                txPhase_ = PHASE_WAIT;
+                txDeadline_ = getDeadline(config_.timeout);
+                return;
+            }
+        }
+        if( txStMin_ != 0U )
+        {
+            txDeadline_ = getDeadline(txStMin_);
+            return;
+        }
+    }
+}
+
+bool_t CanTp::sendFlow(FlowStatus status)
+{
+    uint8_t const frame[3] = {
+        static_cast<uint8_t>((PCI_FLOW << 4) | status),
+        config_.blockSize,
+        config_.stMin
+    };
+    return transmit(frame, sizeof(frame));
+}
+
+bool_t CanTp::transmit(const uint8_t* data, size_t size)
+{
+    CanFrame frame;
+    frame.id = config_.txId;
+    frame.isExtended = config_.isExtended;
+    frame.size = CanFrame::DATA_SIZE;
+    for(size_t i(0U); i<FRAME_SIZE; i++)
+    {
+        frame.data[i] = ( i < size ) ? data[i] : config_.padding;
+    }
+    return can_.transmit(frame);
+}
+
+void CanTp::finishTx(Status status)
+{
+    txPhase_ = PHASE_IDLE;
+    txData_ = NULLPTR;
+    txStatus_ = status;
+    api::Runnable* const handler( config_.txHandler );
+    if( handler != NULLPTR )
+    {
+        handler->start();
+    }
+}
+
+void CanTp::finishRx(Status status)
+{
+    // The buffer is given back to the caller, thus it is not overwritten until a new one is given
+    rxPhase_ = PHASE_IDLE;
+    rxBuffer_ = NULLPTR;
+    rxStatus_ = status;
+    api::Runnable* const handler( config_.rxHandler );
+    if( handler != NULLPTR )
+    {
+        handler->start();
+    }
+}
+
+void CanTp::schedule()
+{
+    bool_t isActive( false );
+    uint32_t remaining( 0xFFFFFFFFU );
+    uint32_t const now( cyc_.getCycles() );
+    if( txPhase_ != PHASE_IDLE )
+    {
+        isActive = true;
+        remaining = isExpired(txDeadline_) ? 0U : txDeadline_ - now;
+    }
+    if( rxPhase_ != PHASE_IDLE )
+    {
+        isActive = true;
+        uint32_t const rx( isExpired(rxDeadline_) ? 0U : rxDeadline_ - now );
+        if( rx < remaining )
+        {
+            remaining = rx;
+        }
+    }
+    tim_->cr1.value = 0;
+    if( !isActive )
+    {
+        return;
+    }
+    uint32_t ticks( (remaining / cyclesPerUs_ + TIMER_TICK - 1U) / TIMER_TICK );
+    if( ticks == 0U )
+    {
+        ticks = 1U;
+    }
+    else if( ticks > TIMER_TICKS_MAX )
+    {
+        // A far deadline is reached by a few timer periods
+        ticks = TIMER_TICKS_MAX;
+    }
+    tim_->arr.value = ticks - 1U;
+    // The update request source is the overflow only, thus UG resets the counter and the prescaler without UIF
+    reg::Tim::Cr1 cr1(0);
+    cr1.bit.urs = 1;
+    cr1.bit.opm = 1;
+    tim_->cr1.value = cr1.value;
+    tim_->egr.bit.ug = 1;
+    cr1.bit.cen = 1;
+    tim_->cr1.value = cr1.value;
+}
+
+uint32_t CanTp::getDeadline(uint32_t time) const
+{
+    return cyc_.getCycles() + time * cyclesPerUs_;
+}
+
+bool_t CanTp::isExpired(uint32_t deadline) const
+{
+    return static_cast<int32_t>(cyc_.getCycles() - deadline) >= 0;
+}
+
+uint32_t CanTp::getSeparationTime(uint8_t stMin)
+{
+    if( stMin <= 0x7FU )
+    {
+        return static_cast<uint32_t>(stMin) * 1000U;
+    }
+    if( stMin >= 0xF1U && stMin <= 0xF9U )
+    {
+        return static_cast<uint32_t>(stMin - 0xF0U) * 100U;
+    }
+    // Reserved values are taken as the longest time
+    return 0x7FU * 1000U;
+}
+
+void CanTp::enableTimerClock(bool_t enable)
+{
+    if( config_.timer == Registers::INDEX_TIM6 )
+    {
+        reg_.rcc->apb1enr.bit.tim6en = enable ? 1 : 0;
+    }
+    else
+    {
+        reg_.rcc->apb1enr.bit.tim7en = enable ? 1 : 0;
+    }
+}
+
+CanTp::Config::Config()
+    : txId(0x7E0)
+    , rxId(0x7E8)
+    , isExtended(false)
+    , blockSize(0U)
+    , stMin(0U)
+    , padding(0xCC)
+    , timer(Registers::INDEX_TIM6)
+    , timeout(1000000)
+    , txHandler(NULLPTR)
+    , rxHandler(NULLPTR) {
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,69 @@
+/**
+ * @file      cpu.CycleCounter.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.CycleCounter.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+CycleCounter::CycleCounter(Registers& reg, api::Guard& gie)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie)
+    , dwt_(reg.dwt) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+CycleCounter::~CycleCounter()
+{
+}
+
+bool_t CycleCounter::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t CycleCounter::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !initialize() )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+bool_t CycleCounter::initialize()
+{
+    lib::Guard<NoAllocator> const guard(gie_);
+    // Enable the DWT unit
+    reg_.scs.debug->demcr.bit.trcena = 1;
+    // Test if the cycle counter is implemented
+    if( dwt_->ctrl.bit.nocyccnt == 1 )
+    {
+        return false;
+    }
+    if( dwt_->ctrl.bit.cyccntena == 0 )
+    {
+        dwt_->cyccnt.value = 0;
+        dwt_->ctrl.bit.cyccntena = 1;
+    }
+    return true;
+}
+
+} // namespace cpu
+} // namespace eoos
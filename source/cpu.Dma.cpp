@@ -0,0 +1,121 @@
+/**
+ * @file      cpu.Dma.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.Dma.hpp"
+#include "cpu.Interrupt.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+Dma::Channel::Channel()
+    : dma(-1)
+    , number(-1) {
+}
+
+Dma::Channel::Channel(int32_t adma, int32_t anumber)
+    : dma(adma)
+    , number(anumber) {
+}
+
+bool_t Dma::Channel::isChannel() const
+{
+    if( dma == Registers::INDEX_DMA1 )
+    {
+        return 1 <= number && number <= 7;
+    }
+    if( dma == Registers::INDEX_DMA2 )
+    {
+        return 1 <= number && number <= 5;
+    }
+    return false;
+}
+
+Dma::Dma(Registers& reg, api::Guard& gie)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+Dma::~Dma()
+{
+}
+
+bool_t Dma::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t Dma::enableClock(const Channel& channel)
+{
+    if( !isConstructed() || !channel.isChannel() )
+    {
+        return false;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    if( channel.dma == Registers::INDEX_DMA1 )
+    {
+        reg_.rcc->ahbenr.bit.dma1en = 1;
+    }
+    else
+    {
+        reg_.rcc->ahbenr.bit.dma2en = 1;
+    }
+    return true;
+}
+
+reg::Dma::Channel* Dma::getRegisters(const Channel& channel) const
+{
+    if( !channel.isChannel() )
+    {
+        return NULLPTR;
+    }
+    return &reg_.dma[channel.dma]->channel[channel.number - 1];
+}
+
+uint32_t Dma::getFlags(const Channel& channel) const
+{
+    return ( reg_.dma[channel.dma]->isr.value >> getShift(channel) ) & 0xFU;
+}
+
+void Dma::clearFlags(const Channel& channel, uint32_t flags)
+{
+    reg_.dma[channel.dma]->ifcr.value = (flags & 0xFU) << getShift(channel);
+}
+
+int32_t Dma::getException(const Channel& channel)
+{
+    if( !channel.isChannel() )
+    {
+        return -1;
+    }
+    if( channel.dma == Registers::INDEX_DMA1 )
+    {
+        return Interrupt<NoAllocator>::EXCEPTION_DMA1_CHANNEL1 + channel.number - 1;
+    }
+    // DMA2 channels 4 and 5 share one exception
+    if( channel.number >= 4 )
+    {
+        return Interrupt<NoAllocator>::EXCEPTION_DMA2_CHANNEL4_5;
+    }
+    return Interrupt<NoAllocator>::EXCEPTION_DMA2_CHANNEL1 + channel.number - 1;
+}
+
+bool_t Dma::construct()
+{
+    return isConstructed();
+}
+
+uint32_t Dma::getShift(const Channel& channel)
+{
+    return static_cast<uint32_t>(channel.number - 1) << 2;
+}
+
+} // namespace cpu
+} // namespace eoos
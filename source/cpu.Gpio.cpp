@@ -0,0 +1,109 @@
+/**
+ * @file      cpu.Gpio.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.Gpio.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+Gpio::Pin::Pin()
+    : port(-1)
+    , number(-1) {
+}
+
+Gpio::Pin::Pin(int32_t aport, int32_t anumber)
+    : port(aport)
+    , number(anumber) {
+}
+
+bool_t Gpio::Pin::isPin() const
+{
+    if( port < 0 || port >= NUMBER_OF_PORTS )
+    {
+        return false;
+    }
+    if( number < 0 || number >= NUMBER_OF_PINS )
+    {
+        return false;
+    }
+    return true;
+}
+
+Gpio::Gpio(Registers& reg, api::Guard& gie)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+Gpio::~Gpio()
+{
+}
+
+bool_t Gpio::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t Gpio::setMode(const Pin& pin, Mode mode)
+{
+    if( !isConstructed() || !pin.isPin() )
+    {
+        return false;
+    }
+    uint32_t const shift( static_cast<uint32_t>(pin.number & 0x7) << 2 );
+    uint32_t const bits( static_cast<uint32_t>(mode) << shift );
+    uint32_t const mask( 0xFU << shift );
+    reg::Gpio* const gpio( reg_.gpio[pin.port] );
+    lib::Guard<NoAllocator> const guard(gie_);
+    // Enable the alternate function IO and the port clocks, as IOPAEN is bit 2 and others follow it
+    reg_.rcc->apb2enr.value |= 0x00000001U | ( 0x00000004U << pin.port );
+    if( pin.number < 8 )
+    {
+        gpio->crl.value = (gpio->crl.value & ~mask) | bits;
+    }
+    else
+    {
+        gpio->crh.value = (gpio->crh.value & ~mask) | bits;
+    }
+    return true;
+}
+
+void Gpio::set(const Pin& pin)
+{
+    if( pin.isPin() )
+    {
+        reg_.gpio[pin.port]->bsrr.value = 0x00000001U << pin.number;
+    }
+}
+
+void Gpio::reset(const Pin& pin)
+{
+    if( pin.isPin() )
+    {
+        reg_.gpio[pin.port]->bsrr.value = 0x00010000U << pin.number;
+    }
+}
+
+bool_t Gpio::get(const Pin& pin) const
+{
+    if( !pin.isPin() )
+    {
+        return false;
+    }
+    return ( reg_.gpio[pin.port]->idr.value & (0x00000001U << pin.number) ) != 0U;
+}
+
+bool_t Gpio::construct()
+{
+    return isConstructed();
+}
+
+} // namespace cpu
+} // namespace eoos
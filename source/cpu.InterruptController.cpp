@@ -48,8 +48,9 @@ InterruptController::InterruptController(Registers& reg, api::Guard& gie)
     , api::CpuInterruptController()
     , reg_(reg)
     , gie_(gie)
+    , nvic_(reg_, gie_)
     , memory_(gie_)
-    , data_(reg_, gie_) {
+    , data_(reg_, gie_, nvic_) {
     bool_t const isConstructed( construct() );
     setConstructed( isConstructed );
 }
@@ -126,6 +127,11 @@ int32_t InterruptController::getNumberPendSupervisor() const
     return Resource::EXCEPTION_PENDSV;
 }
 
+Nvic& InterruptController::getNvic()
+{
+    return nvic_;
+}
+
 bool_t InterruptController::construct()
 {
     bool_t res( false );
@@ -135,6 +141,10 @@ bool_t InterruptController::construct()
         {
             break;
         }
+        if( !nvic_.isConstructed() )
+        {
+            break;
+        }
         if( !memory_.isConstructed() )
         {
             break;
@@ -143,6 +153,16 @@ bool_t InterruptController::construct()
         {
             break;
         }
+        #ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+        // Set the scheduler exceptions to a level under MemManage, which saves a task context to a stack guard
+        reg_.scs.scb->shpr[1].bit.priN3 = SCHEDULER_PRIORITY;
+        reg_.scs.scb->shpr[2].bit.priN2 = SCHEDULER_PRIORITY;
+        reg_.scs.scb->shpr[2].bit.priN3 = SCHEDULER_PRIORITY;
+        #endif // EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+        #ifdef EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING
+        // Set PendSV to the lowest priority level to switch a task context after all other ISRs
+        reg_.scs.scb->shpr[2].bit.priN2 = 0xFF;
+        #endif // EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING
         res = true;
     } while(false);
     return res;
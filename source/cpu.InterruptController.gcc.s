@@ -16,9 +16,11 @@
                 .global CpuInterruptController_jumpSvcLow
                 .global CpuInterruptGlobal_disableLow
                 .global CpuInterruptGlobal_enableLow
+                .global v_tcb_running
                 
                 .extern d_tos_main
                 .extern CpuInterruptController_handleException
+                .extern CpuMpuController_handleFault
 
 /**
  * @brief Exception handler macro.
@@ -112,13 +114,22 @@ m_vectors:      .word   d_tos_main                /*  00 |   - |   - | Main stac
                 .word   m_handle_dma2_channel3    /*  74 |  58 |  65 | ISR DMA2 Channel 3 Global Interrupt                */
                 .word   m_handle_dma2_channel4_5  /*  75 |  59 |  66 | ISR DMA2 Channel 4 and Channel 5 Global Interrupts */
 
+                .bss
+                .align  2
+/**
+ * @brief TCB of the task which context is on the CPU.
+ */
+v_tcb_running:  .space  4
+
                 .text
 /**
  * @brief Common exception routine enterence.
  */
 HANDLE_EXCEPTION m_handle_nmi              2
 HANDLE_EXCEPTION m_handle_hardfault        3
+.ifndef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
 HANDLE_EXCEPTION m_handle_memmanage        4
+.endif
 HANDLE_EXCEPTION m_handle_busfault         5
 HANDLE_EXCEPTION m_handle_usagefault       6
 HANDLE_EXCEPTION m_handle_debugmon         12
@@ -192,6 +203,15 @@ m_handle_exception:
                 bl      CpuInterruptController_handleException
                 bx      r8
 
+.ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+/**
+ * @brief MemManage fault routine reports a thread stack overflow.
+ */
+                .thumb_func
+m_handle_memmanage:
+                b       CpuMpuController_handleFault
+.endif
+
 /**
  * @brief Reset vector routine.
  */
@@ -256,8 +276,29 @@ m_handle_pendsv:
  */
                 .thumb_func
 m_handle_systick:
+.ifdef EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING
+                /* Call the exception high level routine */
+                push    {r3, lr}
+                mov     r0, #15
+                bl      CpuInterruptController_handleException
+                pop     {r3, lr}
+                /* Return if the high level routine has not switched pxCurrentTCB */
+                ldr     r3, pxCurrentTCBConst
+                ldr     r1, [r3]
+                ldr     r3, vTcbRunningConst
+                ldr     r2, [r3]
+                cmp     r1, r2
+                it      eq
+                bxeq    lr
+                /* Make PendSV exception pending to switch the context there */
+                ldr     r3, =0xE000ED04
+                mov     r2, #0x10000000
+                str     r2, [r3]
+                bx      lr
+.else
                 mov     r12, #15
                 b       m_handle_scheduler
+.endif
 
 /**
  * @brief System scheduler routine.
@@ -266,6 +307,8 @@ m_handle_systick:
  * The routine extends ARMv7-M exception entry behavior by pushing registers on stack.
  * The saved stack is shown below:
  *
+ * | RBAR    | <- PSP of a task on SW save if EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+ * | RASR    |
  * | R4      | <- PSP of a task on SW save
  * | R5      |
  * | R6      |
@@ -287,32 +330,76 @@ m_handle_systick:
  * Note that Thread mode uses SP_process and Handler mode uses SP_main, thus
  * the task R13(SP) on enerence saves in PSP, and the routine use MSP.
  *
+ * The exception high level routine is called first, and the remained registers 
+ * are saved and loaded only if pxCurrentTCB differs from the task which context
+ * is on the CPU. The task is kept in v_tcb_running, as the high level routine of 
+ * SysTick might switch pxCurrentTCB but leave the switching to PendSV if 
+ * EOOS_GLOBAL_CPU_ENABLE_PENDSV_SWITCHING is defined. The high level routine 
+ * keeps R4-R11 of the interrupted task following AAPCS.
+ *
+ * If EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD is defined, the stack guard MPU region
+ * RBAR and RASR values are saved and loaded with the task context.
+ *
+ * pxTopOfStack of the interrupted task is set to its SP after the SW save before
+ * the high level routine is called, thus the kernel checks the stack of the task
+ * for overflow by the SP of the current run even if the task is not switched out.
+ *
  * @param R12 Scheduler exeption number
  */
                 .thumb_func
 m_handle_scheduler:
-                /* Save the remained registers on the Process stack of interrupted thread */
+                /* Save SP the interrupted thread will have after the SW save to its pxTopOfStack */
+                ldr     r3, vTcbRunningConst
+                ldr     r3, [r3]
                 mrs     r0, psp
-                isb
-                stmdb   r0!, {r4-r11}
-                /* Save new SP of interrupted thread to pxCurrentTCB->pxTopOfStack */                
-                ldr	    r7, pxCurrentTCBConst
-                ldr	    r1, [r7]
-                str     r0, [r1]                
+.ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+                subs    r0, #40
+.else
+                subs    r0, #32
+.endif
+                str     r0, [r3]
                 /* Call the exception high level routine */
+                push    {r3, lr}
                 mov     r0, r12
-                mov     r8, lr
                 bl      CpuInterruptController_handleException
-                mov     lr, r8
-                /* Load saved SP of a new thread from pxCurrentTCB->pxTopOfStack */                
-                ldr     r1, [r7]
+                pop     {r3, lr}
+                /* Return if pxCurrentTCB is the task which context is on the CPU */
+                ldr     r3, pxCurrentTCBConst
+                ldr     r1, [r3]
+                ldr     r3, vTcbRunningConst
+                ldr     r2, [r3]
+                cmp     r1, r2
+                it      eq
+                bxeq    lr
+                str     r1, [r3]
+                /* Save the remained registers on the Process stack of interrupted thread */
+                mrs     r0, psp
+                isb
+                stmdb   r0!, {r4-r11}
+.ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+                /* Save the stack guard region of interrupted thread */
+                ldr     r12, =0xE000ED9C
+                ldmia   r12, {r3, r4}
+                stmdb   r0!, {r3, r4}
+.endif
+                /* Save new SP of interrupted thread to its pxTopOfStack */
+                str     r0, [r2]
+                /* Load saved SP of a new thread from pxCurrentTCB->pxTopOfStack */
                 ldr     r0, [r1]
-                /* Load the remained registers from the Process stack of a new thread */                
+.ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+                /* Load the stack guard region of a new thread */
+                ldmia   r0!, {r3, r4}
+                stmia   r12, {r3, r4}
+                dsb
+.endif
+                /* Load the remained registers from the Process stack of a new thread */
                 ldmia   r0!, {r4-r11}
                 msr     psp, r0
-                isb	
+                isb
                 bx      lr
+                .align  2
 pxCurrentTCBConst: .word pxCurrentTCB
+vTcbRunningConst:  .word v_tcb_running
 
 /**
  * @fn void CpuInterruptController_jumpUsrLow();
@@ -0,0 +1,51 @@
+/**
+ * @file      cpu.LinProtocol.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.LinProtocol.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+const uint8_t LinProtocol::PID[NUMBER_OF_IDS] = {
+    0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47,
+    0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,
+    0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97,
+    0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,
+    0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7,
+    0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,
+    0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37,
+    0x78, 0x39, 0xBA, 0xFB, 0x3C, 0x7D, 0xFE, 0xBF
+};
+
+uint8_t LinProtocol::getPid(uint8_t id)
+{
+    return PID[id & 0x3FU];
+}
+
+bool_t LinProtocol::isPid(uint8_t pid)
+{
+    return PID[pid & 0x3FU] == pid;
+}
+
+uint8_t LinProtocol::getChecksum(uint8_t pid, const uint8_t* data, size_t size, bool_t enhanced)
+{
+    // Diagnostic frames 0x3C and 0x3D always use the classic checksum
+    uint32_t const id( pid & 0x3FU );
+    uint32_t sum( ( enhanced && id < 0x3CU ) ? pid : 0U );
+    for(size_t i(0U); i<size; i++)
+    {
+        sum += data[i];
+        if( sum > 0xFFU )
+        {
+            sum -= 0xFFU;
+        }
+    }
+    return static_cast<uint8_t>(~sum);
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,218 @@
+/**
+ * @file      cpu.MpuController.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.MpuController.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @brief TCB of the task which context is on the CPU.
+ */
+extern "C" void* v_tcb_running;
+
+/**
+ * @brief Handles MemManage fault.
+ */
+extern "C" void CpuMpuController_handleFault()
+{
+    MpuController::handleFault();
+}
+
+/**
+ * @brief Sets a stack guard region to a thread context.
+ *
+ * @param sp    Stack pointer returned by CpuRegistersController::initializeStack().
+ * @param stack Lowest address of the thread stack.
+ * @return True if the guard is set.
+ */
+extern "C" bool CpuMpuController_setStackGuard(void* sp, void* stack)
+{
+    return MpuController::setGuard(sp, stack);
+}
+
+MpuController* MpuController::this_( NULLPTR );
+
+MpuController::MpuController(Registers& reg, api::Guard& gie)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie)
+    , handler_(NULLPTR)
+    , report_() {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+MpuController::~MpuController()
+{
+    deinitialize();
+}
+
+bool_t MpuController::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t MpuController::setStackGuard(void* sp, void* stack)
+{
+    #ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+    if( !isConstructed() || sp == NULLPTR || stack == NULLPTR )
+    {
+        return false;
+    }
+    uint32_t const base( (reinterpret_cast<uint32_t>(stack) + GUARD_SIZE - 1U) & ~(GUARD_SIZE - 1U) );
+    // Test the guard does not overlap the initial context of the thread
+    if( base + GUARD_SIZE > reinterpret_cast<uint32_t>(sp) )
+    {
+        return false;
+    }
+    reg::Mpu::Rbar rbar(0);
+    rbar.bit.region = GUARD_REGION;
+    rbar.bit.valid = 1;
+    rbar.bit.addr = base >> 5;
+    // Region of 2^(size+1) bytes
+    uint32_t size( 4U );
+    while( (2U << size) < GUARD_SIZE )
+    {
+        size++;
+    }
+    reg::Mpu::Rasr rasr(0);
+    rasr.bit.enable = 1;
+    rasr.bit.size = size;
+    rasr.bit.s = 1;     // Normal shareable memory as SRAM is
+    rasr.bit.c = 1;
+    rasr.bit.ap = 0;    // No access for privileged and user software
+    rasr.bit.xn = 1;    // Instruction fetches disabled
+    // The initial context of a thread keeps RBAR and RASR values lowest
+    uint32_t* const frame( reinterpret_cast<uint32_t*>(sp) );
+    frame[0] = rbar.value;
+    frame[1] = rasr.value;
+    return true;
+    #else
+    return false;
+    #endif // EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+}
+
+bool_t MpuController::setGuard(void* sp, void* stack)
+{
+    if( this_ == NULLPTR )
+    {
+        return false;
+    }
+    return this_->setStackGuard(sp, stack);
+}
+
+void MpuController::setOverflowHandler(api::Runnable* handler)
+{
+    lib::Guard<NoAllocator> const guard(gie_);
+    handler_ = handler;
+}
+
+const MpuController::Report& MpuController::getReport() const
+{
+    return report_;
+}
+
+void MpuController::handleFault()
+{
+    if( this_ == NULLPTR )
+    {
+        while(true){}
+    }
+    Report& report( this_->report_ );
+    reg::Scb::Cfsr const cfsr( this_->reg_.scs.scb->cfsr.value );
+    report.cfsr = cfsr.value;
+    report.address = ( cfsr.bit.mmfsrMmarvalid == 1 ) ? this_->reg_.scs.scb->mmfar.value : 0U;
+    report.guard = static_cast<uint32_t>(this_->reg_.scs.mpu->rbar.bit.addr) << 5;
+    report.tcb = v_tcb_running;
+    if( cfsr.bit.mmfsrMstkerr == 1 )
+    {
+        report.fault = FAULT_STACKING;
+    }
+    else if( cfsr.bit.mmfsrMmarvalid == 1 && report.guard <= report.address && report.address < report.guard + GUARD_SIZE )
+    {
+        report.fault = FAULT_OVERFLOW;
+    }
+    else
+    {
+        report.fault = FAULT_OTHER;
+    }
+    // Clear the MemManage fault status bits by writing ones
+    this_->reg_.scs.scb->cfsr.value = cfsr.value & 0x000000FFU;
+    if( this_->handler_ != NULLPTR )
+    {
+        this_->handler_->start();
+    }
+    this_->halt();
+}
+
+bool_t MpuController::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( this_ != NULLPTR )
+        {
+            break;
+        }
+        if( !initialize() )
+        {
+            break;
+        }
+        this_ = this;
+        res = true;
+    } while(false);
+    return res;
+}
+
+bool_t MpuController::initialize()
+{
+    #ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+    // Test if the MPU is implemented and has the guard region
+    if( reg_.scs.mpu->type.bit.dregion <= GUARD_REGION )
+    {
+        return false;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    reg_.scs.mpu->ctrl.value = 0;
+    reg_.scs.mpu->rnr.value = GUARD_REGION;
+    reg_.scs.mpu->rbar.value = 0;
+    reg_.scs.mpu->rasr.value = 0;
+    reg::Mpu::Ctrl ctrl(0);
+    ctrl.bit.privdefena = 1;    // Use the default memory map out of the enabled regions
+    ctrl.bit.enable = 1;
+    reg_.scs.mpu->ctrl.value = ctrl.value;
+    reg_.scs.scb->shcsr.bit.memfaultena = 1;
+    #endif // EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+    return true;
+}
+
+void MpuController::deinitialize()
+{
+    if( this_ == this )
+    {
+        #ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+        lib::Guard<NoAllocator> const guard(gie_);
+        reg_.scs.mpu->ctrl.value = 0;
+        #endif // EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+        this_ = NULLPTR;
+    }
+}
+
+void MpuController::halt()
+{
+    static_cast<void>( gie_.lock() );
+    while(true){}
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,119 @@
+/**
+ * @file      cpu.Nvic.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.Nvic.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+Nvic::Mask::Mask()
+{
+    for(int32_t i(0); i<NUMBER_OF_WORDS; i++)
+    {
+        word[i] = 0;
+    }
+}
+
+bool_t Nvic::Mask::add(int32_t irq)
+{
+    if( !isIrq(irq) )
+    {
+        return false;
+    }
+    word[getIndex(irq)] |= getBit(irq);
+    return true;
+}
+
+Nvic::Nvic(Registers& reg, api::Guard& gie)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+Nvic::~Nvic()
+{
+}
+
+bool_t Nvic::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+void Nvic::enable(int32_t irq)
+{
+    if( isIrq(irq) )
+    {
+        reg_.scs.nvic->iser[getIndex(irq)].value = getBit(irq);
+    }
+}
+
+void Nvic::disable(int32_t irq)
+{
+    if( isIrq(irq) )
+    {
+        reg_.scs.nvic->icer[getIndex(irq)].value = getBit(irq);
+    }
+}
+
+void Nvic::enable(const Mask& mask)
+{
+    lib::Guard<NoAllocator> const guard(gie_);
+    for(int32_t i(0); i<NUMBER_OF_WORDS; i++)
+    {
+        if( mask.word[i] != 0U )
+        {
+            reg_.scs.nvic->iser[i].value = mask.word[i];
+        }
+    }
+}
+
+void Nvic::disable(const Mask& mask)
+{
+    lib::Guard<NoAllocator> const guard(gie_);
+    for(int32_t i(0); i<NUMBER_OF_WORDS; i++)
+    {
+        if( mask.word[i] != 0U )
+        {
+            reg_.scs.nvic->icer[i].value = mask.word[i];
+        }
+    }
+}
+
+bool_t Nvic::isIrq(int32_t irq)
+{
+    return 0 <= irq && irq < NUMBER_OF_IRQS;
+}
+
+bool_t Nvic::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+uint32_t Nvic::getBit(int32_t irq)
+{
+    return 0x00000001UL << ( static_cast<uint32_t>(irq) & 0x1FU );
+}
+
+int32_t Nvic::getIndex(int32_t irq)
+{
+    return static_cast<int32_t>( static_cast<uint32_t>(irq) >> 5 );
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -4,6 +4,7 @@
  * @copyright 2017-2023, Sergey Baigudin, Baigudin Software
  */ 
 #include "cpu.PllController.hpp"
+#include "cpu.BitBand.hpp"
 
 namespace eoos
 {
@@ -38,6 +39,84 @@ int64_t PllController::getCpuClock()
     return 72000000;
 }
 
+int64_t PllController::getSystemClock() const
+{
+    reg::Rcc::Cfgr const cfgr( reg_.rcc->cfgr.value );
+    switch(cfgr.bit.sws)
+    {
+        case 0:
+        {
+            return HSI_CLOCK;
+        }
+        case 1:
+        {
+            return HSE_CLOCK;
+        }
+        case 2:
+        {
+            int64_t clock( 0 );
+            if( cfgr.bit.pllsrc == 0 )
+            {
+                clock = HSI_CLOCK / 2;
+            }
+            else
+            {
+                clock = ( cfgr.bit.pllxtpre == 0 ) ? HSE_CLOCK : HSE_CLOCK / 2;
+            }
+            // PLLMUL 0000 is 2x and so on to 1110 which is 16x, as 1111 is 16x too
+            int64_t const mul( ( cfgr.bit.pllmul == 15 ) ? 16 : static_cast<int64_t>(cfgr.bit.pllmul) + 2 );
+            return clock * mul;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+int64_t PllController::getAhbClock() const
+{
+    reg::Rcc::Cfgr const cfgr( reg_.rcc->cfgr.value );
+    // HPRE 0xxx is not divided, 1000 to 1011 is divided by 2 to 16, and 1100 to 1111 is divided by 64 to 512
+    uint32_t shift( 0 );
+    if( cfgr.bit.hpre >= 12 )
+    {
+        shift = cfgr.bit.hpre - 6;
+    }
+    else if( cfgr.bit.hpre >= 8 )
+    {
+        shift = cfgr.bit.hpre - 7;
+    }
+    else
+    {
+        shift = 0;
+    }
+    return getSystemClock() >> shift;
+}
+
+int64_t PllController::getApb1Clock() const
+{
+    return getApbClock( reg_.rcc->cfgr.bit.ppre1 );
+}
+
+int64_t PllController::getApb2Clock() const
+{
+    return getApbClock( reg_.rcc->cfgr.bit.ppre2 );
+}
+
+bool_t PllController::resume()
+{
+    // The stop mode turns HSE and PLL off but keeps the prescalers and the flash latency
+    return setSysClkTo72();
+}
+
+int64_t PllController::getApbClock(uint32_t ppre) const
+{
+    // PPRE 0xx is not divided, and 100 to 111 is divided by 2 to 16
+    uint32_t const shift( ( ppre >= 4 ) ? ppre - 3 : 0 );
+    return getAhbClock() >> shift;
+}
+
 bool_t PllController::construct()
 {
     bool_t res( false );
@@ -146,7 +225,7 @@ bool_t PllController::setSysClkTo72()
 
     bool_t res( false );
     bool_t isHserdy( false );
-    reg_.rcc->cr.bit.hseon = 1; // Set HSE clock enable to HSE oscillator ON
+    BitBand::set(reg_.rcc->cr, reg::Rcc::Cr::HSEON_BIT); // Set HSE clock enable to HSE oscillator ON
     for(int32_t i(0); i<REG_RCC_HSERDY_TIMEOUT; i++)
     {
         if(reg_.rcc->cr.bit.hserdy == 1)
@@ -158,7 +237,7 @@ bool_t PllController::setSysClkTo72()
     if( isHserdy )
     {
         {
-            reg_.flash->acr.bit.prftbe = 1;           // Set Prefetch buffer status to Prefetch buffer is enabled
+            BitBand::set(reg_.flash->acr, reg::Flash::Acr::PRFTBE_BIT); // Set Prefetch buffer status to Prefetch buffer is enabled
             reg_.flash->acr.bit.latency = 0;          // Reset Flash Latency
             reg_.flash->latencyex.bit.latency43 = 0;  // Reset Flash Latency
             reg_.flash->acr.bit.latency = 2;          // Set Flash Latency to 00010 wait period for 48 MHz < HCLK <= 72 MHz
@@ -25,7 +25,14 @@ Processor::Processor()
     , abi_()
     , pll_(reg_, gie_)
     , int_(reg_, gie_) 
-    , tim_(reg_, gie_) {
+    , tim_(reg_, gie_)
+    , mpu_(reg_, gie_)
+    , gpio_(reg_, gie_)
+    , dma_(reg_, gie_)
+    , usart_(reg_, gie_, int_, gpio_, dma_, pll_)
+    , lin_(reg_, gie_, int_, gpio_, pll_)
+    , can_(reg_, gie_, int_, gpio_, pll_)
+    , cyc_(reg_, gie_) {
     bool_t const isConstructed( construct() );
     setConstructed( isConstructed );
 }    
@@ -74,6 +81,31 @@ api::CpuTimerController& Processor::getTimerController()
     return tim_;
 }
 
+MpuController& Processor::getMpuController()
+{
+    return mpu_;
+}
+
+UsartController& Processor::getUsartController()
+{
+    return usart_;
+}
+
+LinController& Processor::getLinController()
+{
+    return lin_;
+}
+
+CanController& Processor::getCanController()
+{
+    return can_;
+}
+
+CycleCounter& Processor::getCycleCounter()
+{
+    return cyc_;
+}
+
 bool_t Processor::construct()
 {
     bool_t res( false );
@@ -103,6 +135,34 @@ bool_t Processor::construct()
         {
             break;
         }
+        if( !mpu_.isConstructed() )
+        {
+            break;
+        }
+        if( !gpio_.isConstructed() )
+        {
+            break;
+        }
+        if( !dma_.isConstructed() )
+        {
+            break;
+        }
+        if( !usart_.isConstructed() )
+        {
+            break;
+        }
+        if( !lin_.isConstructed() )
+        {
+            break;
+        }
+        if( !can_.isConstructed() )
+        {
+            break;
+        }
+        if( !cyc_.isConstructed() )
+        {
+            break;
+        }
         res = true;
     } while(false);    
     return res; 
@@ -12,8 +12,11 @@ namespace cpu
     
 Registers::Registers()
     : rcc   ( new (reg::Rcc::ADDRESS)   reg::Rcc   )
+    , pwr   ( new (reg::Pwr::ADDRESS)   reg::Pwr   )
+    , exti  ( new (reg::Exti::ADDRESS)  reg::Exti  )
     , flash ( new (reg::Flash::ADDRESS) reg::Flash )
     , dbg   ( new (reg::Dbg::ADDRESS)   reg::Dbg   )
+    , dwt   ( new (reg::Dwt::ADDRESS)   reg::Dwt   )
     , scs() {
 
     usart[INDEX_USART1] = new (reg::Usart::ADDRESS_USART1) reg::Usart;
@@ -30,13 +33,21 @@ Registers::Registers()
     gpio[INDEX_GPIOC] = new (reg::Gpio::ADDRESS_GPIOC) reg::Gpio;
     gpio[INDEX_GPIOD] = new (reg::Gpio::ADDRESS_GPIOD) reg::Gpio;
     gpio[INDEX_GPIOE] = new (reg::Gpio::ADDRESS_GPIOE) reg::Gpio;
+
+    dma[INDEX_DMA1] = new (reg::Dma::ADDRESS_DMA1) reg::Dma;
+    dma[INDEX_DMA2] = new (reg::Dma::ADDRESS_DMA2) reg::Dma;
+
+    tim[INDEX_TIM6] = new (reg::Tim::ADDRESS_TIM6) reg::Tim;
+    tim[INDEX_TIM7] = new (reg::Tim::ADDRESS_TIM7) reg::Tim;
 }
    
 Registers::Scs::Scs()
     : aux  ( new (reg::Auxiliary::ADDRESS) reg::Auxiliary )
     , tick ( new (reg::SysTick::ADDRESS)   reg::SysTick   ) 
     , nvic ( new (reg::Nvic::ADDRESS)      reg::Nvic      ) 
-    , scb  ( new (reg::Scb::ADDRESS)       reg::Scb       ) {
+    , scb  ( new (reg::Scb::ADDRESS)       reg::Scb       ) 
+    , mpu  ( new (reg::Mpu::ADDRESS)       reg::Mpu       ) 
+    , debug( new (reg::CoreDebug::ADDRESS) reg::CoreDebug ) {
 }  
     
 } // namespace cpu
@@ -54,6 +54,10 @@ void* RegistersController::initializeStack(void* stack, void* entry, void* exit,
     *--sp = 0x66666600 | id;                    // R6
     *--sp = 0x55555500 | id;                    // R5
 	*--sp = 0x44444400 | id;                    // R4
+    #ifdef EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
+    *--sp = 0x00000000;                         // MPU RASR of disabled stack guard region
+    *--sp = 0x00000000;                         // MPU RBAR of the stack guard region
+    #endif // EOOS_GLOBAL_CPU_ENABLE_STACK_GUARD
     return sp;
 }
 
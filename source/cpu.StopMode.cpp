@@ -0,0 +1,74 @@
+/**
+ * @file      cpu.StopMode.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.StopMode.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @brief Waits for an event.
+ */
+extern "C" void CpuStopMode_waitLow();
+
+StopMode::StopMode(Registers& reg, api::Guard& gie, PllController& pll)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie)
+    , pll_(pll) {
+    setConstructed( pll_.isConstructed() );
+}
+
+StopMode::~StopMode()
+{
+}
+
+bool_t StopMode::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+bool_t StopMode::enter(CanController::Resource& can)
+{
+    if( !isConstructed() || !can.isConstructed() )
+    {
+        return false;
+    }
+    if( !can.sleep() )
+    {
+        return false;
+    }
+    bool_t isResumed( false );
+    {
+        // Interrupts are masked not to be handled with the clocks of the stop mode, and an event wakes the CPU up
+        lib::Guard<NoAllocator> const guard(gie_);
+        reg::Exti::Line::Value const line( 1U << CAN_RX_LINE );
+        reg_.exti->pr.value = line;
+        reg_.exti->ftsr.value = reg_.exti->ftsr.value | line;
+        reg_.exti->emr.value = reg_.exti->emr.value | line;
+        reg_.rcc->apb1enr.bit.pwren = 1;
+        reg::Pwr::Cr cr( reg_.pwr->cr.value );
+        cr.bit.pdds = 0;
+        cr.bit.lpds = 1;
+        cr.bit.cwuf = 1;
+        reg_.pwr->cr.value = cr.value;
+        reg_.scs.scb->scr.bit.sleepdeep = 1;
+        CpuStopMode_waitLow();
+        reg_.scs.scb->scr.bit.sleepdeep = 0;
+        reg_.exti->emr.value = reg_.exti->emr.value & ~line;
+        reg_.exti->ftsr.value = reg_.exti->ftsr.value & ~line;
+        reg_.exti->pr.value = line;
+        isResumed = pll_.resume();
+    }
+    // The controller is woken up by software as its automatic wake-up would lose the next frame too
+    bool_t const isAwake( can.wakeUp() );
+    return isResumed && isAwake;
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,31 @@
+/**
+ * @file      cpu.StopMode.gcc.s
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ *
+ * @brief Stop mode low level module of STM32F103xx like XL-density (Non-connectivity) devices.
+ */
+                .arch armv7-m
+                .cpu cortex-m3
+                .fpu softvfp
+                .syntax unified
+                .thumb
+
+                .global CpuStopMode_waitLow
+
+                .text
+
+/**
+ * @fn void CpuStopMode_waitLow();
+ * @brief Waits for an event.
+ *
+ * The event register is set by SEV and cleared by the first WFE, thus the second WFE
+ * waits for a new event even if an event has been signalled before.
+ */
+                .thumb_func
+CpuStopMode_waitLow:
+                dsb
+                sev
+                wfe
+                wfe
+                bx      lr
@@ -0,0 +1,285 @@
+/**
+ * @file      cpu.Trace.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.Trace.hpp"
+#include "lib.Guard.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+/**
+ * @brief Reserves an index of a buffer by LDREX and STREX.
+ *
+ * @param head  Free-running head index.
+ * @param limit The tail plus a buffer size.
+ * @param index Reserved index.
+ * @return True if the index is reserved.
+ */
+extern "C" bool_t CpuTrace_reserveLow(uint32_t volatile* head, uint32_t limit, uint32_t* index);
+
+/**
+ * @brief Increments a value by LDREX and STREX.
+ *
+ * @param value A value.
+ */
+extern "C" void CpuTrace_incrementLow(uint32_t volatile* value);
+
+/**
+ * @brief Tests if the CPU is in Handler mode.
+ *
+ * @return True if an exception is being handled.
+ */
+extern "C" bool_t CpuTrace_isHandlerLow();
+
+Trace* Trace::this_( NULLPTR );
+
+Trace::Trace(UsartController::Resource& usart, CycleCounter& cyc, api::Guard& gie, Record* thread, size_t threadSize, Record* handler, size_t handlerSize)
+    : NonCopyable<NoAllocator>()
+    , api::Runnable()
+    , usart_(usart)
+    , cyc_(cyc)
+    , gie_(gie)
+    , buffer_()
+    , transfer_()
+    , context_(CONTEXT_THREAD)
+    , sending_(0)
+    , isBusy_(false) {
+    bool_t const isConstructed( construct(thread, threadSize, handler, handlerSize) );
+    setConstructed( isConstructed );
+}
+
+Trace::~Trace()
+{
+    lib::Guard<NoAllocator> const guard(gie_);
+    if( this_ == this )
+    {
+        this_ = NULLPTR;
+    }
+}
+
+bool_t Trace::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+void Trace::start()
+{
+    Buffer& buffer( buffer_[context_] );
+    uint32_t const tail( buffer.tail );
+    for(uint32_t i(0U); i<sending_; i++)
+    {
+        buffer.record[(tail + i) & (buffer.size - 1U)].header = 0U;
+    }
+    // Release the records for producers only after their headers are cleared
+    buffer.tail = tail + sending_;
+    sending_ = 0U;
+    isBusy_ = false;
+    drain();
+}
+
+void Trace::drain()
+{
+    if( !isConstructed() )
+    {
+        return;
+    }
+    lib::Guard<NoAllocator> const guard(gie_);
+    if( isBusy_ )
+    {
+        return;
+    }
+    // Alternate the buffers to not starve one of them
+    int32_t const first( (context_ + 1) % NUMBER_OF_CONTEXTS );
+    for(int32_t i(0); i<NUMBER_OF_CONTEXTS; i++)
+    {
+        int32_t const context( (first + i) % NUMBER_OF_CONTEXTS );
+        putLost(context);
+        if( send(context) )
+        {
+            break;
+        }
+    }
+}
+
+uint32_t Trace::getLost(Context context) const
+{
+    return buffer_[context].lost;
+}
+
+void Trace::write(uint16_t id)
+{
+    put(id, 0U, 0U, 0U, 0U);
+}
+
+void Trace::write(uint16_t id, uint32_t a0)
+{
+    put(id, 1U, a0, 0U, 0U);
+}
+
+void Trace::write(uint16_t id, uint32_t a0, uint32_t a1)
+{
+    put(id, 2U, a0, a1, 0U);
+}
+
+void Trace::write(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+    put(id, 3U, a0, a1, a2);
+}
+
+void Trace::write(uint16_t id, const UsartController::Resource::Statistics& statistics)
+{
+    put(id, 3U, statistics.rxBytes, statistics.txBytes, statistics.rxDropped);
+    put(static_cast<uint16_t>(id + 1U), 3U, statistics.overrun, statistics.framing, statistics.noise);
+    put(static_cast<uint16_t>(id + 2U), 3U, statistics.parity, statistics.rxHighWater, statistics.isrCycles);
+}
+
+bool_t Trace::construct(Record* thread, size_t threadSize, Record* handler, size_t handlerSize)
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !usart_.isConstructed() || !cyc_.isConstructed() )
+        {
+            break;
+        }
+        if( thread == NULLPTR || !isPowerOfTwo(threadSize) )
+        {
+            break;
+        }
+        if( handler == NULLPTR || !isPowerOfTwo(handlerSize) )
+        {
+            break;
+        }
+        lib::Guard<NoAllocator> const guard(gie_);
+        // Only one object can be a sink of the static write functions
+        if( this_ != NULLPTR )
+        {
+            break;
+        }
+        buffer_[CONTEXT_THREAD].record = thread;
+        buffer_[CONTEXT_THREAD].size = static_cast<uint32_t>(threadSize);
+        buffer_[CONTEXT_HANDLER].record = handler;
+        buffer_[CONTEXT_HANDLER].size = static_cast<uint32_t>(handlerSize);
+        for(int32_t i(0); i<NUMBER_OF_CONTEXTS; i++)
+        {
+            for(uint32_t j(0U); j<buffer_[i].size; j++)
+            {
+                buffer_[i].record[j].header = 0U;
+            }
+        }
+        transfer_.handler = this;
+        this_ = this;
+        res = true;
+    } while(false);
+    return res;
+}
+
+void Trace::put(uint16_t id, uint32_t count, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+    Trace* const trace( this_ );
+    if( trace == NULLPTR )
+    {
+        return;
+    }
+    int32_t const context( CpuTrace_isHandlerLow() ? CONTEXT_HANDLER : CONTEXT_THREAD );
+    if( !trace->putEvent(context, id, count, a0, a1, a2) )
+    {
+        CpuTrace_incrementLow(&trace->buffer_[context].lost);
+    }
+}
+
+bool_t Trace::putEvent(int32_t context, uint16_t id, uint32_t count, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+    Buffer& buffer( buffer_[context] );
+    uint32_t index;
+    if( !CpuTrace_reserveLow(&buffer.head, buffer.tail + buffer.size, &index) )
+    {
+        return false;
+    }
+    Record volatile& record( buffer.record[index & (buffer.size - 1U)] );
+    record.time = cyc_.getCycles();
+    record.arg[0] = a0;
+    record.arg[1] = a1;
+    record.arg[2] = a2;
+    // The header is written last as it marks the record is ready to transmit
+    record.header = (SYNC << 24) | (static_cast<uint32_t>(context) << 18) | (count << 16) | id;
+    return true;
+}
+
+void Trace::putLost(int32_t context)
+{
+    Buffer& buffer( buffer_[context] );
+    uint32_t const lost( buffer.lost );
+    if( lost == buffer.reported )
+    {
+        return;
+    }
+    if( putEvent(context, EVENT_LOST, 1U, lost - buffer.reported, 0U, 0U) )
+    {
+        buffer.reported = lost;
+    }
+}
+
+bool_t Trace::send(int32_t context)
+{
+    // The DMA number of data register is 16 bits
+    static const uint32_t MAXIMUM_RECORDS( 0x0000FFFFU / sizeof(Record) );
+    Buffer& buffer( buffer_[context] );
+    uint32_t const tail( buffer.tail );
+    uint32_t const head( buffer.head );
+    uint32_t const first( tail & (buffer.size - 1U) );
+    // Records are transmitted in place, thus a transfer stops at the end of the buffer
+    uint32_t limit( buffer.size - first );
+    if( limit > head - tail )
+    {
+        limit = head - tail;
+    }
+    if( limit > MAXIMUM_RECORDS )
+    {
+        limit = MAXIMUM_RECORDS;
+    }
+    uint32_t count( 0U );
+    while( count < limit && buffer.record[first + count].header != 0U )
+    {
+        count++;
+    }
+    if( count == 0U )
+    {
+        return false;
+    }
+    transfer_.data = const_cast<Record*>(&buffer.record[first]);
+    transfer_.size = count * sizeof(Record);
+    if( !usart_.send(transfer_) )
+    {
+        return false;
+    }
+    context_ = context;
+    sending_ = count;
+    isBusy_ = true;
+    return true;
+}
+
+bool_t Trace::isPowerOfTwo(size_t value)
+{
+    return value != 0U && (value & (value - 1U)) == 0U;
+}
+
+Trace::Buffer::Buffer()
+    : record(NULLPTR)
+    , size(0U)
+    , head(0U)
+    , tail(0U)
+    , lost(0U)
+    , reported(0U) {
+}
+
+} // namespace cpu
+} // namespace eoos
@@ -0,0 +1,75 @@
+/**
+ * @file      cpu.Trace.gcc.s
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ *
+ * @brief Trace low level module of STM32F103xx like XL-density (Non-connectivity) devices.
+ */
+                .arch armv7-m
+                .cpu cortex-m3
+                .fpu softvfp
+                .syntax unified
+                .thumb
+
+                .global CpuTrace_reserveLow
+                .global CpuTrace_incrementLow
+                .global CpuTrace_isHandlerLow
+
+                .text
+
+/**
+ * @fn bool CpuTrace_reserveLow(volatile uint32_t* head, uint32_t limit, uint32_t* index);
+ * @brief Increments a free-running head index if it is less than a limit.
+ *
+ * The head is changed by LDREX and STREX, thus any context can reserve an index
+ * of a buffer without interrupts masking.
+ *
+ * @param R0 Head address.
+ * @param R1 Limit of the head, which is the tail plus a buffer size.
+ * @param R2 Address to store the reserved index.
+ * @return True if the index is reserved.
+ */
+                .thumb_func
+CpuTrace_reserveLow:
+m_reserve:      ldrex   r3, [r0]
+                subs    r12, r3, r1
+                bpl     m_reserve_full
+                add     r12, r3, #1
+                str     r3, [r2]
+                strex   r3, r12, [r0]
+                cmp     r3, #0
+                bne     m_reserve
+                mov     r0, #1
+                bx      lr
+m_reserve_full: clrex
+                mov     r0, #0
+                bx      lr
+
+/**
+ * @fn void CpuTrace_incrementLow(volatile uint32_t* value);
+ * @brief Increments a value by LDREX and STREX.
+ *
+ * @param R0 Value address.
+ */
+                .thumb_func
+CpuTrace_incrementLow:
+m_increment:    ldrex   r1, [r0]
+                add     r1, r1, #1
+                strex   r2, r1, [r0]
+                cmp     r2, #0
+                bne     m_increment
+                bx      lr
+
+/**
+ * @fn bool CpuTrace_isHandlerLow();
+ * @brief Tests if the CPU is in Handler mode.
+ *
+ * @return True if an exception is being handled.
+ */
+                .thumb_func
+CpuTrace_isHandlerLow:
+                mrs     r0, IPSR
+                cmp     r0, #0
+                it      ne
+                movne   r0, #1
+                bx      lr
@@ -0,0 +1,48 @@
+/**
+ * @file      cpu.UsartBaud.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.UsartBaud.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+UsartBaud::Result::Result()
+    : brr(0)
+    , baud(0)
+    , ppm(0) {
+}
+
+bool_t UsartBaud::calculate(int64_t clock, int64_t baud, Result& result)
+{
+    if( clock <= 0 || baud <= 0 )
+    {
+        return false;
+    }
+    int64_t const brr( (clock + baud / 2) / baud );
+    if( brr < static_cast<int64_t>(BRR_MIN) || brr > static_cast<int64_t>(BRR_MAX) )
+    {
+        return false;
+    }
+    result.brr = static_cast<uint32_t>(brr);
+    result.baud = getBaud(clock, result.brr);
+    // The error is (clock / brr - baud) / baud scaled to ppm without rounding the achieved baud rate
+    result.ppm = static_cast<int32_t>( (clock * 1000000 - baud * brr * 1000000) / (baud * brr) );
+    return true;
+}
+
+int64_t UsartBaud::getBaud(int64_t clock, uint32_t brr)
+{
+    if( brr < BRR_MIN || brr > BRR_MAX )
+    {
+        return 0;
+    }
+    int64_t const div( static_cast<int64_t>(brr) );
+    return (clock + div / 2) / div;
+}
+
+} // namespace cpu
+} // namespace eoos
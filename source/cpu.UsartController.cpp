@@ -0,0 +1,115 @@
+/**
+ * @file      cpu.UsartController.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ */
+#include "cpu.UsartController.hpp"
+#include "lib.UniquePointer.hpp"
+
+namespace eoos
+{
+namespace cpu
+{
+
+api::Heap* UsartController::resource_( NULLPTR );
+
+UsartController::UsartController(Registers& reg, api::Guard& gie, api::CpuInterruptController& ic, Gpio& gpio, Dma& dma, PllController& pll)
+    : NonCopyable<NoAllocator>()
+    , reg_(reg)
+    , gie_(gie)
+    , memory_(gie_)
+    , data_(reg_, gie_, ic, gpio, dma, pll) {
+    bool_t const isConstructed( construct() );
+    setConstructed( isConstructed );
+}
+
+UsartController::~UsartController()
+{
+    UsartController::deinitialize();
+}
+
+bool_t UsartController::isConstructed() const
+{
+    return Parent::isConstructed();
+}
+
+UsartController::Resource* UsartController::createResource(int32_t index, const Resource::Config& config)
+{
+    Resource* ptr( NULLPTR );
+    if( isConstructed() && Resource::isIndex(index) )
+    {
+        lib::UniquePointer<Resource> res( new Resource(data_, index, config) );
+        if( !res.isNull() )
+        {
+            if( !res->isConstructed() )
+            {
+                res.reset();
+            }
+        }
+        ptr = res.release();
+    }
+    return ptr;
+}
+
+bool_t UsartController::construct()
+{
+    bool_t res( false );
+    do
+    {
+        if( !isConstructed() )
+        {
+            break;
+        }
+        if( !memory_.isConstructed() )
+        {
+            break;
+        }
+        if( !initialize(&memory_) )
+        {
+            break;
+        }
+        res = true;
+    } while(false);
+    return res;
+}
+
+void* UsartController::allocate(size_t size)
+{
+    if( resource_ != NULLPTR )
+    {
+        return resource_->allocate(size, NULLPTR);
+    }
+    else
+    {
+        return NULLPTR;
+    }
+}
+
+void UsartController::free(void* ptr)
+{
+    if( resource_ != NULLPTR )
+    {
+        resource_->free(ptr);
+    }
+}
+
+bool_t UsartController::initialize(api::Heap* resource)
+{
+    if( resource_ != NULLPTR )
+    {
+        return false;
+    }
+    else
+    {
+        resource_ = resource;
+        return true;
+    }
+}
+
+void UsartController::deinitialize()
+{
+    resource_ = NULLPTR;
+}
+
+} // namespace cpu
+} // namespace eoos
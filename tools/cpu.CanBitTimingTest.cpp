@@ -0,0 +1,81 @@
+/**
+ * @file      cpu.CanBitTimingTest.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ *
+ * @brief Host test of the cpu::CanBitTiming class.
+ *
+ * Each calculated BTR value is decoded back, and the bit rate and the sample point it gives on
+ * the hardware must be the ones the calculation reports, including low sample points which
+ * cannot be achieved by all numbers of time quanta.
+ *
+ * Build: g++ -I<EOOS interface> -I../include/protected -o can-bit-timing-test cpu.CanBitTimingTest.cpp ../source/cpu.CanBitTiming.cpp
+ * Usage: can-bit-timing-test
+ */
+#include <stdio.h>
+#include "cpu.CanBitTiming.hpp"
+
+namespace
+{
+
+using eoos::int32_t;
+using eoos::int64_t;
+
+/**
+ * @brief Number of failed checks.
+ */
+int failures( 0 );
+
+/**
+ * @brief Checks a calculated bit timing.
+ *
+ * @param clock       PCLK1 in Hz.
+ * @param bitRate     A bit rate.
+ * @param samplePoint A sample point in per mille.
+ */
+void check(int64_t clock, int64_t bitRate, int32_t samplePoint)
+{
+    using eoos::cpu::CanBitTiming;
+    CanBitTiming::Result result;
+    if( !CanBitTiming::calculate(clock, bitRate, samplePoint, result) )
+    {
+        return;
+    }
+    CanBitTiming::Result decoded;
+    static_cast<void>( CanBitTiming::getBitTiming(clock, result.btr, decoded) );
+    if( decoded.bitRate != result.bitRate || decoded.samplePoint != result.samplePoint )
+    {
+        printf("FAIL clock=%lld rate=%lld sp=%d btr=0x%08X reported %lld/%d decoded %lld/%d\n",
+            static_cast<long long>(clock), static_cast<long long>(bitRate), samplePoint, result.btr,
+            static_cast<long long>(result.bitRate), result.samplePoint,
+            static_cast<long long>(decoded.bitRate), decoded.samplePoint);
+        failures++;
+    }
+}
+
+} // namespace
+
+int main()
+{
+    static const int64_t CLOCKS[] = { 8000000, 24000000, 32000000, 36000000, 42000000 };
+    static const int64_t RATES[] = { 1000000, 800000, 500000, 250000, 125000, 83333, 50000, 10000 };
+    for(size_t i(0U); i<sizeof(CLOCKS) / sizeof(CLOCKS[0]); i++)
+    {
+        for(size_t j(0U); j<sizeof(RATES) / sizeof(RATES[0]); j++)
+        {
+            for(int32_t samplePoint(10); samplePoint<1000; samplePoint+=10)
+            {
+                check(CLOCKS[i], RATES[j], samplePoint);
+            }
+        }
+    }
+    // A sample point of 50 per mille once gave segment 1 of -1 quantum, which BTR TS1 took as 15
+    eoos::cpu::CanBitTiming::Result result;
+    if( eoos::cpu::CanBitTiming::calculate(36000000, 500000, 50, result) && result.bitRate != 500000 )
+    {
+        printf("FAIL low sample point bit rate %lld\n", static_cast<long long>(result.bitRate));
+        failures++;
+    }
+    printf("%s\n", ( failures == 0 ) ? "PASS" : "FAIL");
+    return ( failures == 0 ) ? 0 : 1;
+}
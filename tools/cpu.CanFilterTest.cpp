@@ -0,0 +1,188 @@
+/**
+ * @file      cpu.CanFilterTest.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ *
+ * @brief Host test of the cpu::CanFilter class.
+ *
+ * Filter banks compiled from random rules of standard identifiers, which may overlap, are matched
+ * as the hardware does against all standard identifiers. Each requested identifier must be
+ * accepted, an exact filter element must accept only requested identifiers, the number of
+ * identifiers accepted but not requested must be the one the compilation reports, and more
+ * banks must never accept more identifiers.
+ *
+ * Build: g++ -I<EOOS interface> -I../include/protected -o can-filter-test cpu.CanFilterTest.cpp ../source/cpu.CanFilter.cpp
+ * Usage: can-filter-test
+ */
+#include <stdio.h>
+#include "cpu.CanFilter.hpp"
+
+namespace
+{
+
+using eoos::int32_t;
+using eoos::uint32_t;
+using eoos::cpu::CanFilter;
+
+/**
+ * @brief Number of standard identifiers.
+ */
+const uint32_t NUMBER_OF_IDS = 0x800;
+
+/**
+ * @brief Maximal number of rules of a test.
+ */
+const int32_t RULES_MAX = 24;
+
+/**
+ * @brief Number of failed checks.
+ */
+int failures( 0 );
+
+/**
+ * @brief Term memory.
+ */
+CanFilter::Term terms[512];
+
+/**
+ * @brief Random number generator state.
+ */
+uint32_t seed( 1U );
+
+/**
+ * @brief Returns a random number.
+ *
+ * @param range A range of the number.
+ * @return A number from zero to the range minus one.
+ */
+uint32_t getRandom(uint32_t range)
+{
+    seed = seed * 1103515245U + 12345U;
+    return ((seed >> 8) & 0x00FFFFFFU) % range;
+}
+
+/**
+ * @brief Tests if a filter element matches a standard data frame.
+ *
+ * @param bank    A filter bank.
+ * @param element A filter element index of the bank.
+ * @param id      A standard identifier.
+ * @return True if it matches.
+ */
+bool matches(const CanFilter::Bank& bank, int32_t element, uint32_t id)
+{
+    if( bank.isWide )
+    {
+        uint32_t const frame( id << 21 );
+        if( bank.isList )
+        {
+            return frame == ((element == 0) ? bank.fr1 : bank.fr2);
+        }
+        return ((frame ^ bank.fr1) & bank.fr2) == 0U;
+    }
+    uint32_t const frame( id << 5 );
+    if( bank.isList )
+    {
+        uint32_t const fr( (element < 2) ? bank.fr1 : bank.fr2 );
+        return frame == (((element & 1) != 0) ? (fr >> 16) : (fr & 0x0000FFFFU));
+    }
+    uint32_t const fr( (element == 0) ? bank.fr1 : bank.fr2 );
+    return ((frame ^ fr) & (fr >> 16) & 0x0000FFFFU) == 0U;
+}
+
+/**
+ * @brief Checks filter banks compiled from rules.
+ *
+ * @param rules  Rules of standard identifiers.
+ * @param number Number of the rules.
+ */
+void check(const CanFilter::Rule* rules, int32_t number)
+{
+    bool requested[NUMBER_OF_IDS] = {};
+    for(int32_t i(0); i<number; i++)
+    {
+        for(uint32_t id(rules[i].first); id<=rules[i].last; id++)
+        {
+            requested[id] = true;
+        }
+    }
+    CanFilter filter(terms, sizeof(terms) / sizeof(terms[0]));
+    uint32_t previous( 0xFFFFFFFFU );
+    for(int32_t banks(1); banks<=CanFilter::NUMBER_OF_BANKS; banks++)
+    {
+        if( !filter.compile(rules, number, banks) )
+        {
+            continue;
+        }
+        uint32_t overAccepted( 0U );
+        bool isFailed( filter.getBanks() > banks );
+        for(uint32_t id(0U); id<NUMBER_OF_IDS; id++)
+        {
+            bool isAccepted( false );
+            for(int32_t b(0); b<filter.getBanks(); b++)
+            {
+                CanFilter::Bank const& bank( filter.getBank(b) );
+                for(int32_t e(0); e<bank.elements; e++)
+                {
+                    if( !matches(bank, e, id) )
+                    {
+                        continue;
+                    }
+                    isAccepted = true;
+                    // Software does not filter frames of an exact element
+                    if( (bank.exact & (1U << e)) != 0U && !requested[id] )
+                    {
+                        isFailed = true;
+                    }
+                }
+            }
+            if( requested[id] && !isAccepted )
+            {
+                isFailed = true;
+            }
+            if( !requested[id] && isAccepted )
+            {
+                overAccepted++;
+            }
+        }
+        if( overAccepted != filter.getOverAccepted() || overAccepted > previous )
+        {
+            isFailed = true;
+        }
+        if( isFailed )
+        {
+            printf("FAIL rules=%d banks=%d over-accepted %u reported %u\n",
+                number, banks, overAccepted, filter.getOverAccepted());
+            failures++;
+        }
+        previous = overAccepted;
+    }
+}
+
+} // namespace
+
+int main()
+{
+    // Overlapping rules once counted identifiers twice, and an element accepting 15 was exact
+    CanFilter::Rule const overlapped[] = { CanFilter::Rule(9, 14, false), CanFilter::Rule(10, false) };
+    check(overlapped, 2);
+    CanFilter::Rule rules[RULES_MAX];
+    for(int32_t test(0); test<1200; test++)
+    {
+        int32_t const number( 1 + static_cast<int32_t>(getRandom(RULES_MAX)) );
+        uint32_t const width( ((test & 1) == 0) ? 1U : 64U );
+        for(int32_t i(0); i<number; i++)
+        {
+            uint32_t const first( getRandom(NUMBER_OF_IDS) );
+            uint32_t last( first + getRandom(width) );
+            if( last >= NUMBER_OF_IDS )
+            {
+                last = NUMBER_OF_IDS - 1U;
+            }
+            rules[i] = CanFilter::Rule(first, last, false);
+        }
+        check(rules, number);
+    }
+    printf("%s\n", ( failures == 0 ) ? "PASS" : "FAIL");
+    return ( failures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file      cpu.TraceDecoder.cpp
+ * @author    Sergey Baigudin, sergey@baigudin.software
+ * @copyright 2024, Sergey Baigudin, Baigudin Software
+ *
+ * @brief Host decoder of binary records of the cpu::Trace class.
+ *
+ * The decoder reads records from a file or the standard input, for example a serial port
+ * configured by `stty -F /dev/ttyUSB0 raw 921600`, and prints one event per line. The 32 bits
+ * CPU clock cycles of records are extended to 64 bits separately for each context.
+ *
+ * Build: g++ -O2 -o trace-decoder cpu.TraceDecoder.cpp
+ * Usage: trace-decoder [-c CPU_CLOCK_HZ] [FILE]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+namespace
+{
+
+/**
+ * @brief Size of a record in bytes.
+ */
+const size_t RECORD_SIZE = 20;
+
+/**
+ * @brief Synchronization byte of a record header.
+ */
+const uint8_t SYNC = 0xA5;
+
+/**
+ * @brief Event identifier of lost events.
+ */
+const uint32_t EVENT_LOST = 0xFFFF;
+
+/**
+ * @brief Reads a little-endian word.
+ *
+ * @param data Bytes of the word.
+ * @return The word.
+ */
+uint32_t getWord(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0])
+        | (static_cast<uint32_t>(data[1]) << 8)
+        | (static_cast<uint32_t>(data[2]) << 16)
+        | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+/**
+ * @brief Tests if bytes are a record header.
+ *
+ * @param data Bytes of the header.
+ * @return True if the header is valid.
+ */
+bool isHeader(const uint8_t* data)
+{
+    uint32_t const header( getWord(data) );
+    return (header >> 24) == SYNC && ((header >> 19) & 0x1F) == 0;
+}
+
+/**
+ * @brief Extended time of a context.
+ */
+struct Time
+{
+    bool isValid;
+    uint32_t last;
+    uint64_t value;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    double clock( 0.0 );
+    const char* path( NULL );
+    for(int i(1); i<argc; i++)
+    {
+        if( std::strcmp(argv[i], "-c") == 0 && i + 1 < argc )
+        {
+            clock = std::atof(argv[++i]);
+        }
+        else if( path == NULL )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [-c CPU_CLOCK_HZ] [FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE* file( stdin );
+    if( path != NULL )
+    {
+        file = std::fopen(path, "rb");
+        if( file == NULL )
+        {
+            std::perror(path);
+            return 1;
+        }
+    }
+    Time time[2] = { {false, 0, 0}, {false, 0, 0} };
+    uint8_t record[RECORD_SIZE];
+    size_t length( 0 );
+    uint64_t skipped( 0 );
+    while( true )
+    {
+        size_t const count( std::fread(record + length, 1, RECORD_SIZE - length, file) );
+        if( count == 0 )
+        {
+            break;
+        }
+        length += count;
+        if( length < RECORD_SIZE )
+        {
+            continue;
+        }
+        // Resynchronize by the header byte by byte if a record is broken
+        if( !isHeader(record) )
+        {
+            std::memmove(record, record + 1, RECORD_SIZE - 1);
+            length = RECORD_SIZE - 1;
+            skipped++;
+            continue;
+        }
+        length = 0;
+        uint32_t const header( getWord(record) );
+        uint32_t const id( header & 0xFFFF );
+        uint32_t const number( (header >> 16) & 0x3 );
+        uint32_t const context( (header >> 18) & 0x1 );
+        uint32_t const cycles( getWord(record + 4) );
+        // Records of a context are sent in order, and the counter wraps not more than once between them
+        Time& t( time[context] );
+        if( t.isValid )
+        {
+            t.value += static_cast<uint32_t>(cycles - t.last);
+        }
+        else
+        {
+            t.value = cycles;
+            t.isValid = true;
+        }
+        t.last = cycles;
+        if( skipped != 0 )
+        {
+            std::printf("# %llu bytes skipped\n", static_cast<unsigned long long>(skipped));
+            skipped = 0;
+        }
+        if( clock > 0.0 )
+        {
+            std::printf("%16.3f us", static_cast<double>(t.value) * 1000000.0 / clock);
+        }
+        else
+        {
+            std::printf("%20llu", static_cast<unsigned long long>(t.value));
+        }
+        std::printf(" %c", context == 0 ? 'T' : 'H');
+        if( id == EVENT_LOST )
+        {
+            std::printf(" LOST %lu\n", static_cast<unsigned long>(getWord(record + 8)));
+            continue;
+        }
+        std::printf(" %5lu", static_cast<unsigned long>(id));
+        for(uint32_t i(0); i<number; i++)
+        {
+            std::printf(" 0x%08lX", static_cast<unsigned long>(getWord(record + 8 + i * 4)));
+        }
+        std::printf("\n");
+    }
+    if( file != stdin )
+    {
+        std::fclose(file);
+    }
+    return 0;
+}